@@ -0,0 +1,561 @@
+#include <benchmark/benchmark.h>
+#include "../include/fixed_block_memory_resource.h"
+#include "../include/doubly_linked_list.h"
+#include "../include/unrolled_linked_list.h"
+#include "../include/concurrent_deque.h"
+#include "../include/offset_linked_list.h"
+#include "../include/persistent_list.h"
+#include "../include/synchronized_fixed_block_memory_resource.h"
+#include <algorithm>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+// Структура того же размера, что и color из main.cpp
+struct color {
+    std::string name;
+    int r, g, b;
+
+    color(const std::string& n, int red, int green, int blue)
+        : name(n), r(red), g(green), b(blue) {}
+};
+
+namespace {
+    constexpr size_t POOL_SIZE{256 * 1024 * 1024};
+
+    // Ресурсы, с которыми сравнивается fixed_block_memory_resource
+    struct fixed_block {
+        static std::unique_ptr<std::pmr::memory_resource> make() {
+            return std::make_unique<fixed_block_memory_resource>(POOL_SIZE);
+        }
+    };
+
+    struct unsynchronized_pool {
+        static std::unique_ptr<std::pmr::memory_resource> make() {
+            return std::make_unique<std::pmr::unsynchronized_pool_resource>();
+        }
+    };
+
+    struct monotonic_buffer {
+        static std::unique_ptr<std::pmr::memory_resource> make() {
+            return std::make_unique<std::pmr::monotonic_buffer_resource>();
+        }
+    };
+
+    template <typename T>
+    T make_value(int i);
+
+    template <>
+    int make_value<int>(int i) {
+        return i;
+    }
+
+    template <>
+    color make_value<color>(int i) {
+        return color("Color", i, i, i);
+    }
+}
+
+// Выделение и освобождение блоков размера узла списка вперемешку
+template <typename Resource>
+static void BM_AllocateDeallocateChurn(benchmark::State& state) {
+    auto mr = Resource::make();
+    const size_t live = static_cast<size_t>(state.range(0));
+    std::vector<void*> pointers(live, nullptr);
+    size_t step = 0;
+    for (auto _ : state) {
+        size_t slot = (step * 7919) % live; // Псевдослучайный порядок освобождения
+        if (pointers[slot]) {
+            mr->deallocate(pointers[slot], 32, alignof(std::max_align_t));
+        }
+        pointers[slot] = mr->allocate(32, alignof(std::max_align_t));
+        benchmark::DoNotOptimize(pointers[slot]);
+        ++step;
+    }
+    for (void* ptr : pointers) {
+        if (ptr) {
+            mr->deallocate(ptr, 32, alignof(std::max_align_t));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_AllocateDeallocateChurn, fixed_block)->Range(1 << 8, 1 << 14);
+BENCHMARK_TEMPLATE(BM_AllocateDeallocateChurn, unsynchronized_pool)->Range(1 << 8, 1 << 14);
+BENCHMARK_TEMPLATE(BM_AllocateDeallocateChurn, monotonic_buffer)->Range(1 << 8, 1 << 14);
+
+// push_back в doubly_linked_list над разными ресурсами
+template <typename T, typename Resource>
+static void BM_ListPushBack(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        auto mr = Resource::make();
+        doubly_linked_list<T> list(mr.get());
+        for (int i = 0; i < count; ++i) {
+            list.push_back(make_value<T>(i));
+        }
+        benchmark::DoNotOptimize(list.size());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_ListPushBack, int, fixed_block)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_ListPushBack, int, unsynchronized_pool)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_ListPushBack, int, monotonic_buffer)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_ListPushBack, color, fixed_block)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_ListPushBack, color, unsynchronized_pool)->Range(1 << 10, 1 << 16);
+
+// push_back в std::list для сравнения
+template <typename T>
+static void BM_StdListPushBack(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        std::list<T> list;
+        for (int i = 0; i < count; ++i) {
+            list.push_back(make_value<T>(i));
+        }
+        benchmark::DoNotOptimize(list.size());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_StdListPushBack, int)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_StdListPushBack, color)->Range(1 << 10, 1 << 16);
+
+// Очередь: push_front с одной стороны, pop_back с другой
+template <typename T, typename Resource>
+static void BM_ListPushFrontPopBack(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    auto mr = Resource::make();
+    doubly_linked_list<T> list(mr.get());
+    for (int i = 0; i < count; ++i) {
+        list.push_front(make_value<T>(i));
+    }
+    int i = 0;
+    for (auto _ : state) {
+        list.push_front(make_value<T>(i++));
+        list.pop_back();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_ListPushFrontPopBack, int, fixed_block)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_ListPushFrontPopBack, int, unsynchronized_pool)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_ListPushFrontPopBack, color, fixed_block)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_ListPushFrontPopBack, color, unsynchronized_pool)->Range(1 << 10, 1 << 16);
+
+// Обход списка
+template <typename Resource>
+static void BM_ListIterate(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    auto mr = Resource::make();
+    doubly_linked_list<int> list(mr.get());
+    for (int i = 0; i < count; ++i) {
+        list.push_back(i);
+    }
+    for (auto _ : state) {
+        long long sum = 0;
+        for (int value : list) {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_ListIterate, fixed_block)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_ListIterate, unsynchronized_pool)->Range(1 << 10, 1 << 18);
+
+static void BM_StdListIterate(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    std::list<int> list;
+    for (int i = 0; i < count; ++i) {
+        list.push_back(i);
+    }
+    for (auto _ : state) {
+        long long sum = 0;
+        for (int value : list) {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_StdListIterate)->Range(1 << 10, 1 << 18);
+
+// Заполнение и clear()
+template <typename T, typename Resource>
+static void BM_ListClear(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    auto mr = Resource::make();
+    doubly_linked_list<T> list(mr.get());
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (int i = 0; i < count; ++i) {
+            list.push_back(make_value<T>(i));
+        }
+        state.ResumeTiming();
+        list.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_ListClear, int, fixed_block)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_ListClear, int, unsynchronized_pool)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_ListClear, color, fixed_block)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_ListClear, color, unsynchronized_pool)->Range(1 << 10, 1 << 16);
+
+// sort() на месте против std::list::sort и обхода через std::vector
+template <typename Resource>
+static void BM_ListSort(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    auto mr = Resource::make();
+    doubly_linked_list<int> list(mr.get());
+    for (auto _ : state) {
+        state.PauseTiming();
+        list.clear();
+        for (int i = 0; i < count; ++i) {
+            list.push_back((i * 7919) % count);
+        }
+        state.ResumeTiming();
+        list.sort();
+        benchmark::DoNotOptimize(*list.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_ListSort, fixed_block)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_ListSort, unsynchronized_pool)->Range(1 << 10, 1 << 18);
+
+static void BM_StdListSort(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    std::list<int> list;
+    for (auto _ : state) {
+        state.PauseTiming();
+        list.clear();
+        for (int i = 0; i < count; ++i) {
+            list.push_back((i * 7919) % count);
+        }
+        state.ResumeTiming();
+        list.sort();
+        benchmark::DoNotOptimize(*list.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_StdListSort)->Range(1 << 10, 1 << 18);
+
+// Прежний способ: копия в std::vector, std::sort и повторное заполнение
+template <typename Resource>
+static void BM_ListSortViaVector(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    auto mr = Resource::make();
+    doubly_linked_list<int> list(mr.get());
+    for (auto _ : state) {
+        state.PauseTiming();
+        list.clear();
+        for (int i = 0; i < count; ++i) {
+            list.push_back((i * 7919) % count);
+        }
+        state.ResumeTiming();
+        std::vector<int> values(list.begin(), list.end());
+        std::sort(values.begin(), values.end());
+        list.clear();
+        for (int value : values) {
+            list.push_back(value);
+        }
+        benchmark::DoNotOptimize(*list.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_ListSortViaVector, fixed_block)->Range(1 << 10, 1 << 18);
+
+// unrolled_linked_list против узла на элемент: push_back и обход
+template <typename T, typename Resource>
+static void BM_UnrolledPushBack(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        auto mr = Resource::make();
+        unrolled_linked_list<T> list(mr.get());
+        for (int i = 0; i < count; ++i) {
+            list.push_back(make_value<T>(i));
+        }
+        benchmark::DoNotOptimize(list.size());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_UnrolledPushBack, int, fixed_block)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_UnrolledPushBack, int, unsynchronized_pool)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_UnrolledPushBack, color, fixed_block)->Range(1 << 10, 1 << 16);
+
+template <typename Resource>
+static void BM_UnrolledIterate(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    auto mr = Resource::make();
+    unrolled_linked_list<int> list(mr.get());
+    for (int i = 0; i < count; ++i) {
+        list.push_back(i);
+    }
+    for (auto _ : state) {
+        long long sum = 0;
+        for (int value : list) {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_UnrolledIterate, fixed_block)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_UnrolledIterate, unsynchronized_pool)->Range(1 << 10, 1 << 18);
+
+// Построение списка из диапазона: узлы выделяются одним участком пула
+template <typename Resource>
+static void BM_ListRangeConstruct(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    std::vector<int> source(count);
+    for (int i = 0; i < count; ++i) {
+        source[i] = i;
+    }
+    auto mr = Resource::make();
+    for (auto _ : state) {
+        doubly_linked_list<int> list(source.begin(), source.end(), mr.get());
+        benchmark::DoNotOptimize(list.size());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_ListRangeConstruct, fixed_block)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_ListRangeConstruct, unsynchronized_pool)->Range(1 << 10, 1 << 18);
+
+// pooled_doubly_linked_list: узлы из typed_node_pool без виртуальных вызовов
+template <typename T>
+static void BM_PooledListPushBack(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        node_pool_for<T> pool;
+        pooled_doubly_linked_list<T> list(&pool);
+        for (int i = 0; i < count; ++i) {
+            list.push_back(make_value<T>(i));
+        }
+        benchmark::DoNotOptimize(list.size());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_PooledListPushBack, int)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_PooledListPushBack, color)->Range(1 << 10, 1 << 16);
+
+template <typename T>
+static void BM_PooledListPushFrontPopBack(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    node_pool_for<T> pool;
+    pooled_doubly_linked_list<T> list(&pool);
+    for (int i = 0; i < count; ++i) {
+        list.push_front(make_value<T>(i));
+    }
+    int i = 0;
+    for (auto _ : state) {
+        list.push_front(make_value<T>(i++));
+        list.pop_back();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_PooledListPushFrontPopBack, int)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_PooledListPushFrontPopBack, color)->Range(1 << 10, 1 << 16);
+
+// Масштабирование parallel_reduce и parallel_for_each по числу потоков
+static void BM_ListParallelReduce(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    const size_t threads = static_cast<size_t>(state.range(1));
+    node_pool_for<int> pool;
+    pooled_doubly_linked_list<int> list(&pool);
+    for (int i = 0; i < count; ++i) {
+        list.push_back(i);
+    }
+    for (auto _ : state) {
+        long long sum = list.parallel_reduce(0LL, std::plus<>(), threads);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ListParallelReduce)->ArgsProduct({{1 << 22}, benchmark::CreateRange(1, 16, 2)})->UseRealTime();
+
+static void BM_ListParallelForEach(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    const size_t threads = static_cast<size_t>(state.range(1));
+    node_pool_for<color> pool;
+    pooled_doubly_linked_list<color> list(&pool);
+    for (int i = 0; i < count; ++i) {
+        list.push_back(make_value<color>(i));
+    }
+    for (auto _ : state) {
+        list.parallel_for_each([](color& c) {
+            c.r = (c.r * 31 + c.g) & 0xff;
+        }, threads);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ListParallelForEach)->ArgsProduct({{1 << 20}, benchmark::CreateRange(1, 16, 2)})->UseRealTime();
+
+// Обход списка, узлы которого разбросаны по пулу: после sort() по случайным
+// ключам соседние элементы лежат в случайных блоках
+static void fill_shuffled(doubly_linked_list<int>& list, int count) {
+    for (int i = 0; i < count; ++i) {
+        list.push_back(static_cast<int>((static_cast<unsigned>(i) * 2654435761u) % static_cast<unsigned>(count)));
+    }
+    list.sort();
+}
+
+static void BM_ListIterateShuffled(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    fixed_block_memory_resource mr(POOL_SIZE);
+    doubly_linked_list<int> list(&mr);
+    fill_shuffled(list, count);
+    for (auto _ : state) {
+        long long sum = 0;
+        for (int value : list) {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ListIterateShuffled)->Range(1 << 12, 1 << 20);
+
+// Точки разбиения строятся до замера: список между итерациями не меняется
+static void BM_ListForEachPrefetchedShuffled(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    const size_t streams = static_cast<size_t>(state.range(1));
+    fixed_block_memory_resource mr(POOL_SIZE);
+    doubly_linked_list<int> list(&mr);
+    fill_shuffled(list, count);
+    list.for_each_prefetched([](int) {}, streams);
+    for (auto _ : state) {
+        long long sum = 0;
+        list.for_each_prefetched([&sum](int value) { sum += value; }, streams);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ListForEachPrefetchedShuffled)->ArgsProduct({benchmark::CreateRange(1 << 12, 1 << 20, 16), {1, 4, 8, 16}});
+
+// Обход списка со связями-смещениями против указателей в одном пуле;
+// bytes_per_element - прирост used пула на элемент
+static void BM_ListIteratePooled(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    fixed_block_memory_resource mr(POOL_SIZE);
+    doubly_linked_list<int> list(&mr);
+    size_t used = mr.get_used_memory();
+    for (int i = 0; i < count; ++i) {
+        list.push_back(i);
+    }
+    state.counters["bytes_per_element"] = static_cast<double>(mr.get_used_memory() - used) / count;
+    for (auto _ : state) {
+        long long sum = 0;
+        for (int value : list) {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ListIteratePooled)->Range(1 << 10, 1 << 20);
+
+static void BM_OffsetListIterate(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    fixed_block_memory_resource mr(POOL_SIZE);
+    offset_linked_list<int> list(mr);
+    size_t used = mr.get_used_memory();
+    for (int i = 0; i < count; ++i) {
+        list.push_back(i);
+    }
+    state.counters["bytes_per_element"] = static_cast<double>(mr.get_used_memory() - used) / count;
+    for (auto _ : state) {
+        long long sum = 0;
+        for (int value : list) {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_OffsetListIterate)->Range(1 << 10, 1 << 20);
+
+static void BM_OffsetListPushBack(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    fixed_block_memory_resource mr(POOL_SIZE);
+    for (auto _ : state) {
+        offset_linked_list<int> list(mr);
+        for (int i = 0; i < count; ++i) {
+            list.push_back(i);
+        }
+        benchmark::DoNotOptimize(list.size());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_OffsetListPushBack)->Range(1 << 10, 1 << 18);
+
+// Повторное открытие списка из файла: время не зависит от числа элементов
+static void BM_PersistentListReopen(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    std::string path = (std::filesystem::temp_directory_path() / "bench_persistent_list.pool").string();
+    std::filesystem::remove(path);
+    {
+        persistent_list<int> list(path, 64 * 1024 * 1024);
+        for (int i = 0; i < count; ++i) {
+            list.list().push_back(i);
+        }
+    }
+    for (auto _ : state) {
+        persistent_list<int> list(path, 0);
+        benchmark::DoNotOptimize(list.list().size());
+    }
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_PersistentListReopen)->Range(1 << 10, 1 << 20);
+
+// Очередь работ: чётные потоки производят в конец, нечётные забирают из начала.
+// Список под одним мьютексом против concurrent_deque с мьютексом на каждом конце
+static void BM_MutexListQueue(benchmark::State& state) {
+    static std::unique_ptr<synchronized_fixed_block_memory_resource> mr;
+    static std::unique_ptr<doubly_linked_list<int>> list;
+    static std::mutex list_lock;
+    if (state.thread_index() == 0) {
+        mr = std::make_unique<synchronized_fixed_block_memory_resource>(POOL_SIZE);
+        list = std::make_unique<doubly_linked_list<int>>(mr.get());
+    }
+    const bool producer = state.thread_index() % 2 == 0;
+    int i = 0;
+    for (auto _ : state) {
+        std::lock_guard<std::mutex> lock(list_lock);
+        if (producer) {
+            list->push_back(i++);
+        } else if (!list->empty()) {
+            list->pop_front();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        list.reset();
+        mr.reset();
+    }
+}
+BENCHMARK(BM_MutexListQueue)->ThreadRange(2, 32)->UseRealTime();
+
+static void BM_ConcurrentDequeQueue(benchmark::State& state) {
+    static std::unique_ptr<synchronized_fixed_block_memory_resource> mr;
+    static std::unique_ptr<concurrent_deque<int>> deque;
+    if (state.thread_index() == 0) {
+        mr = std::make_unique<synchronized_fixed_block_memory_resource>(POOL_SIZE);
+        deque = std::make_unique<concurrent_deque<int>>(mr.get());
+    }
+    const bool producer = state.thread_index() % 2 == 0;
+    int i = 0;
+    for (auto _ : state) {
+        if (producer) {
+            deque->push_back(i++);
+        } else {
+            benchmark::DoNotOptimize(deque->try_pop_front());
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        deque.reset();
+        mr.reset();
+    }
+}
+BENCHMARK(BM_ConcurrentDequeQueue)->ThreadRange(2, 32)->UseRealTime();
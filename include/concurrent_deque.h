@@ -0,0 +1,193 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+// Потокобезопасная двусторонняя очередь (MPMC) на двусвязном списке.
+// У каждого конца свой мьютекс: пока элементов не меньше SPLIT_THRESHOLD,
+// операции с разных концов затрагивают разные узлы и идут параллельно,
+// а на почти пустой очереди операция захватывает оба мьютекса.
+// Узел выделяется и конструируется до захвата мьютекса, а извлекается
+// и освобождается после, поэтому под мьютексом только перевешивание
+// указателей. Узел освобождается, только когда он уже отвязан под мьютексом
+// и другие потоки не могут до него добраться, - отложенное освобождение
+// (hazard pointers, эпохи) не требуется.
+// memory_resource должен быть потокобезопасным, например
+// synchronized_fixed_block_memory_resource
+template <typename T>
+class concurrent_deque {
+    private:
+        struct NodeBase {
+            NodeBase* prev{nullptr};
+            NodeBase* next{nullptr};
+        };
+        struct Node : NodeBase {
+            T data;
+            template <typename... Args>
+            Node(Args&&... args) : data(std::forward<Args>(args)...) {}
+        };
+
+        // Операция у конца читает и пишет не дальше двух узлов от него,
+        // поэтому при трёх и более элементах концы не пересекаются
+        static constexpr size_t SPLIT_THRESHOLD{3};
+
+        alignas(64) std::mutex front_lock;
+        alignas(64) std::mutex back_lock;
+        alignas(64) std::atomic<size_t> count{0};
+        NodeBase head; // Ограничители: first = head.next, last = tail.prev
+        NodeBase tail;
+        std::pmr::polymorphic_allocator<Node> allocator;
+
+        template <typename... Args>
+        Node* create_node(Args&&... args) {
+            Node* node = allocator.allocate(1);
+            try {
+                std::allocator_traits<decltype(allocator)>::construct(allocator, node, std::forward<Args>(args)...);
+            } catch (...) {
+                allocator.deallocate(node, 1);
+                throw;
+            }
+            return node;
+        }
+
+        void destroy_node(Node* node) {
+            std::allocator_traits<decltype(allocator)>::destroy(allocator, node);
+            allocator.deallocate(node, 1);
+        }
+
+        // Захватывает мьютекс своего конца, а на почти пустой очереди - оба,
+        // всегда в порядке front, back
+        template <typename Operation>
+        auto at_front(Operation operation) {
+            std::unique_lock<std::mutex> front(front_lock);
+            if (count.load(std::memory_order_acquire) >= SPLIT_THRESHOLD) {
+                return operation();
+            }
+            std::lock_guard<std::mutex> back(back_lock);
+            return operation();
+        }
+        template <typename Operation>
+        auto at_back(Operation operation) {
+            std::unique_lock<std::mutex> back(back_lock);
+            if (count.load(std::memory_order_acquire) >= SPLIT_THRESHOLD) {
+                return operation();
+            }
+            back.unlock();
+            std::scoped_lock both(front_lock, back_lock);
+            return operation();
+        }
+
+        static void link_after(NodeBase* prev, NodeBase* node) {
+            NodeBase* next = prev->next;
+            node->prev = prev;
+            node->next = next;
+            next->prev = node;
+            prev->next = node;
+        }
+        static void unlink(NodeBase* node) {
+            node->prev->next = node->next;
+            node->next->prev = node->prev;
+        }
+
+        // Забирает значение из отвязанного узла и освобождает его вне мьютекса
+        std::optional<T> take(Node* node) {
+            if (!node) {
+                return std::nullopt;
+            }
+            struct release_guard {
+                concurrent_deque* owner;
+                Node* node;
+                ~release_guard() { owner->destroy_node(node); }
+            } guard{this, node};
+            return std::optional<T>(std::move(node->data));
+        }
+
+    public:
+        explicit concurrent_deque(std::pmr::memory_resource* mr) : allocator(mr) {
+            head.next = &tail;
+            tail.prev = &head;
+        }
+        ~concurrent_deque() {
+            clear();
+        }
+
+        concurrent_deque(const concurrent_deque&) = delete;
+        concurrent_deque& operator=(const concurrent_deque&) = delete;
+
+        template <typename... Args>
+        void emplace_back(Args&&... args) {
+            Node* node = create_node(std::forward<Args>(args)...);
+            at_back([&] {
+                link_after(tail.prev, node);
+                count.fetch_add(1, std::memory_order_acq_rel);
+            });
+        }
+        template <typename... Args>
+        void emplace_front(Args&&... args) {
+            Node* node = create_node(std::forward<Args>(args)...);
+            at_front([&] {
+                link_after(&head, node);
+                count.fetch_add(1, std::memory_order_acq_rel);
+            });
+        }
+        void push_back(const T& value) {
+            emplace_back(value);
+        }
+        void push_back(T&& value) {
+            emplace_back(std::move(value));
+        }
+        void push_front(const T& value) {
+            emplace_front(value);
+        }
+        void push_front(T&& value) {
+            emplace_front(std::move(value));
+        }
+
+        // Неблокирующее по смыслу извлечение: пустая очередь - nullopt
+        std::optional<T> try_pop_front() {
+            Node* node = at_front([&]() -> Node* {
+                if (head.next == &tail) {
+                    return nullptr;
+                }
+                NodeBase* first = head.next;
+                unlink(first);
+                count.fetch_sub(1, std::memory_order_acq_rel);
+                return static_cast<Node*>(first);
+            });
+            return take(node);
+        }
+        std::optional<T> try_pop_back() {
+            Node* node = at_back([&]() -> Node* {
+                if (tail.prev == &head) {
+                    return nullptr;
+                }
+                NodeBase* last = tail.prev;
+                unlink(last);
+                count.fetch_sub(1, std::memory_order_acq_rel);
+                return static_cast<Node*>(last);
+            });
+            return take(node);
+        }
+
+        // Размер на момент чтения; при параллельных операциях сразу устаревает
+        size_t size() const {
+            return count.load(std::memory_order_acquire);
+        }
+        bool empty() const {
+            return size() == 0;
+        }
+
+        // Удаляет все элементы; не должен выполняться одновременно с другими операциями
+        void clear() {
+            while (head.next != &tail) {
+                NodeBase* first = head.next;
+                unlink(first);
+                destroy_node(static_cast<Node*>(first));
+            }
+            count.store(0, std::memory_order_release);
+        }
+};
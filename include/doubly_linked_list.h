@@ -1,101 +1,707 @@
 #pragma once
 #include "fixed_block_memory_resource.h"
+#include "typed_node_pool.h"
 #include <cassert>
 #include <memory_resource>
 #include <stdexcept>
 #include <iostream>
+#include <type_traits>
+#include <utility>
+#include <iterator>
+#include <functional>
+#include <initializer_list>
+#include <ranges>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <exception>
+#include <optional>
+#include <algorithm>
+#include <array>
+#include <system_error>
 
+// Узел списка вынесен из класса, чтобы его размер был известен до выбора
+// аллокатора: typed_node_pool параметризуется sizeof/alignof узла
 template <typename T>
+struct doubly_linked_list_node {
+    T data;
+    doubly_linked_list_node* prev{nullptr};
+    doubly_linked_list_node* next{nullptr};
+    template <typename ... Args>
+    doubly_linked_list_node(Args&&... args) : data(std::forward<Args>(args)...), prev(nullptr), next(nullptr) {}
+    // Uses-allocator construction: если T поддерживает аллокатор (std::pmr::string,
+    // вложенный doubly_linked_list...), он получает аллокатор списка.
+    // Свой тег вместо std::allocator_arg: иначе std::tuple внутри
+    // polymorphic_allocator::construct принимает его за свой конструктор
+    struct with_allocator_t {};
+    template <typename Alloc, typename ... Args>
+    doubly_linked_list_node(with_allocator_t, Alloc&& alloc, Args&&... args)
+        : data(std::make_obj_using_allocator<T>(alloc, std::forward<Args>(args)...)), prev(nullptr), next(nullptr) {}
+};
 
+// Allocator - аллокатор элементов; для узлов он перепривязывается (rebind).
+// По умолчанию polymorphic_allocator над memory_resource, а typed_node_allocator
+// убирает виртуальный вызов с горячего пути (см. pooled_doubly_linked_list)
+template <typename T, typename Allocator = std::pmr::polymorphic_allocator<T>>
 class doubly_linked_list {
     private:
-        struct Node {
-            T data;
-            Node* prev{nullptr};
-            Node* next{nullptr};
-            template <typename ... Args>
-            Node(Args&&... args) : data(std::forward<Args>(args)...), next(nullptr), prev(nullptr) {}
-        };
+        using Node = doubly_linked_list_node<T>;
+        using node_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+        static constexpr bool is_pmr{std::is_same_v<Allocator, std::pmr::polymorphic_allocator<T>>};
 
         Node* head; // Указатель на первый узел
         Node* tail; // Указатель на последний узел
         size_t list_size; // Количество элементов в списке
-        std::pmr::polymorphic_allocator<Node> allocator; // Аллокатор для узлов
+        node_allocator_type allocator; // Аллокатор для узлов
+        // Точки разбиения для параллельного обхода: каждый chunk-й узел.
+        // Строятся лениво и устаревают при любом изменении связей (version)
+        size_t version{0};
+        mutable std::vector<Node*> split_points;
+        mutable size_t split_version{0};
+        mutable size_t split_chunk{0};
+
+        // Выделяет узел и конструирует в нём элемент из args
+        template <typename... Args>
+        Node* create_node(Args&&... args) {
+            Node* new_node = allocator.allocate(1);
+            try {
+                std::allocator_traits<decltype(allocator)>::construct(allocator, new_node, typename Node::with_allocator_t{},
+                                                                      get_allocator(), std::forward<Args>(args)...);
+            } catch (...) {
+                // Конструктор элемента бросил исключение - возвращаем память
+                allocator.deallocate(new_node, 1);
+                throw;
+            }
+            return new_node;
+        }
+
+        // Связывает узел со списком перед pos; nullptr - в конец списка
+        void link_before(Node* pos, Node* new_node) {
+            Node* prev = pos ? pos->prev : tail;
+            new_node->prev = prev;
+            new_node->next = pos;
+            if (prev) {
+                prev->next = new_node;
+            } else {
+                head = new_node;
+            }
+            if (pos) {
+                pos->prev = new_node;
+            } else {
+                tail = new_node;
+            }
+            ++list_size;
+            ++version;
+        }
+
+        // Вставляет готовую цепочку first..last из count узлов перед pos
+        void link_range_before(Node* pos, Node* first, Node* last, size_t count) {
+            Node* prev = pos ? pos->prev : tail;
+            first->prev = prev;
+            last->next = pos;
+            if (prev) {
+                prev->next = first;
+            } else {
+                head = first;
+            }
+            if (pos) {
+                pos->prev = last;
+            } else {
+                tail = last;
+            }
+            list_size += count;
+            ++version;
+        }
+
+        // Вырезает цепочку first..last из count узлов, не освобождая память
+        void unlink_range(Node* first, Node* last, size_t count) {
+            if (first->prev) {
+                first->prev->next = last->next;
+            } else {
+                head = last->next;
+            }
+            if (last->next) {
+                last->next->prev = first->prev;
+            } else {
+                tail = first->prev;
+            }
+            first->prev = nullptr;
+            last->next = nullptr;
+            list_size -= count;
+            ++version;
+        }
+
+        // Строит цепочку узлов из [first, last) и вставляет её перед pos одним
+        // связыванием. Если размер диапазона известен, а ресурс -
+        // fixed_block_memory_resource, память всех узлов берётся одним
+        // allocate_contiguous. При исключении список не меняется.
+        // Возвращает первый вставленный узел или nullptr
+        template <typename Iterator, typename Sentinel>
+        Node* link_range_from(Node* pos, Iterator first, Sentinel last) {
+            char* bulk = nullptr;
+            size_t bulk_count = 0;
+            size_t stride = 0;
+            if constexpr (is_pmr && std::forward_iterator<Iterator> && alignof(Node) <= alignof(std::max_align_t)) {
+                bulk_count = static_cast<size_t>(std::ranges::distance(first, last));
+                auto* pool = dynamic_cast<fixed_block_memory_resource*>(allocator.resource());
+                if (pool && bulk_count > 1) {
+                    try {
+                        bulk = static_cast<char*>(pool->allocate_contiguous(sizeof(Node), alignof(Node), bulk_count));
+                        stride = pool->block_stride(sizeof(Node));
+                    } catch (const std::bad_alloc&) {
+                        // В "хвосте" нет места под весь диапазон - узлы по одному из корзин
+                        bulk = nullptr;
+                    }
+                }
+            }
+
+            Node* chain_first = nullptr;
+            Node* chain_last = nullptr;
+            size_t count = 0;
+            try {
+                for (; first != last; ++first) {
+                    Node* node;
+                    if (bulk) {
+                        node = reinterpret_cast<Node*>(bulk + count * stride);
+                        std::allocator_traits<decltype(allocator)>::construct(allocator, node, typename Node::with_allocator_t{}, get_allocator(), *first);
+                    } else {
+                        node = create_node(*first);
+                    }
+                    node->prev = chain_last;
+                    if (chain_last) {
+                        chain_last->next = node;
+                    } else {
+                        chain_first = node;
+                    }
+                    chain_last = node;
+                    ++count;
+                }
+            } catch (...) {
+                for (Node* node = chain_first; node;) {
+                    Node* next = node->next;
+                    if (bulk) {
+                        std::allocator_traits<decltype(allocator)>::destroy(allocator, node);
+                    } else {
+                        destroy_node(node);
+                    }
+                    node = next;
+                }
+                for (size_t i = 0; bulk && i < bulk_count; ++i) {
+                    allocator.deallocate(reinterpret_cast<Node*>(bulk + i * stride), 1);
+                }
+                throw;
+            }
+            if (count > 0) {
+                link_range_before(pos, chain_first, chain_last, count);
+            }
+            return chain_first;
+        }
+
+        // Забирает узлы other; ресурсы списков должны совпадать
+        void take_nodes(doubly_linked_list& other) noexcept {
+            head = std::exchange(other.head, nullptr);
+            tail = std::exchange(other.tail, nullptr);
+            list_size = std::exchange(other.list_size, 0);
+            ++version;
+            ++other.version;
+        }
+
+        // Разрушает элемент и возвращает память узла ресурсу
+        void destroy_node(Node* node) {
+            std::allocator_traits<decltype(allocator)>::destroy(allocator, node);
+            allocator.deallocate(node, 1);
+        }
+
+        // Восстанавливает prev и tail по цепочке next после сортировки/слияния
+        void relink_prev() {
+            Node* prev = nullptr;
+            for (Node* current = head; current; current = current->next) {
+                current->prev = prev;
+                prev = current;
+            }
+            tail = prev;
+            ++version;
+        }
+
+        // Отрезает цепочку после n узлов и возвращает её остаток
+        static Node* split_chain(Node* first, size_t n) {
+            for (size_t i = 1; first && i < n; ++i) {
+                first = first->next;
+            }
+            if (!first) {
+                return nullptr;
+            }
+            Node* rest = first->next;
+            first->next = nullptr;
+            return rest;
+        }
+
+        // Дописывает цепочку по next в конец first..last
+        static void append_chain(Node*& first, Node*& last, Node* chain) {
+            if (!chain) {
+                return;
+            }
+            if (last) {
+                last->next = chain;
+            } else {
+                first = chain;
+            }
+            last = chain;
+            while (last->next) {
+                last = last->next;
+            }
+        }
+
+        // Сливает две отсортированные цепочки по next в first..last (устойчиво).
+        // Если comp бросает, остатки доклеиваются, и ни один узел не теряется
+        template <typename Compare>
+        static void merge_chains(Node* a, Node* b, Compare& comp, Node*& first, Node*& last) {
+            first = nullptr;
+            last = nullptr;
+            try {
+                while (a && b) {
+                    Node*& source = comp(b->data, a->data) ? b : a;
+                    Node* node = source;
+                    source = source->next;
+                    if (last) {
+                        last->next = node;
+                    } else {
+                        first = node;
+                    }
+                    last = node;
+                }
+            } catch (...) {
+                if (last) {
+                    last->next = nullptr;
+                }
+                append_chain(first, last, a);
+                append_chain(first, last, b);
+                throw;
+            }
+            append_chain(first, last, a ? a : b);
+        }
+
+        // Подсказка процессору загрузить узел в кэш заранее
+        static void prefetch(const Node* node) {
+#if defined(__GNUC__)
+            __builtin_prefetch(node);
+#else
+            (void)node;
+#endif
+        }
+
+        // Обход с предвыборкой. Список делится точками разбиения на куски по
+        // PREFETCH_CHUNK узлов, и streams курсоров проходят куски впереди текущего:
+        // курсор lane обходит куски lane, lane + streams, ... Цепочки курсоров не
+        // зависят друг от друга, поэтому их промахи по кэшу обслуживаются
+        // одновременно, а f получает узлы, уже загруженные курсорами
+        template <typename Function>
+        void prefetched_walk(Function& f, size_t streams) const {
+            streams = std::clamp<size_t>(streams, 1, MAX_PREFETCH_STREAMS);
+            const std::vector<Node*>& points = splits(PREFETCH_CHUNK);
+            const size_t chunks = points.size();
+            auto chunk_begin = [&](size_t chunk) { return chunk < chunks ? points[chunk] : nullptr; };
+
+            std::array<Node*, MAX_PREFETCH_STREAMS> lanes{};
+            std::array<Node*, MAX_PREFETCH_STREAMS> lane_ends{};
+            for (size_t chunk = 1; chunk < streams; ++chunk) {
+                lanes[chunk] = chunk_begin(chunk);
+                lane_ends[chunk] = chunk_begin(chunk + 1);
+            }
+            size_t step = 0;
+            for (size_t chunk = 0; chunk < chunks; ++chunk) {
+                // Курсор только что пройденного куска уходит на streams кусков вперёд
+                size_t lane = chunk % streams;
+                lanes[lane] = chunk_begin(chunk + streams);
+                lane_ends[lane] = chunk_begin(chunk + streams + 1);
+
+                Node* end = chunk_begin(chunk + 1);
+                for (Node* current = points[chunk]; current != end; current = current->next) {
+                    // Раз в streams узлов каждый курсор делает шаг: за streams кусков
+                    // курсор проходит свой кусок целиком
+                    if (++step == streams) {
+                        step = 0;
+                        for (size_t i = 0; i < streams; ++i) {
+                            if (lanes[i] != lane_ends[i]) {
+                                prefetch(lanes[i]->next);
+                                lanes[i] = lanes[i]->next;
+                            }
+                        }
+                    }
+                    f(current->data);
+                }
+            }
+        }
+
+        // Точки разбиения с шагом chunk, перестраиваются после изменений списка
+        const std::vector<Node*>& splits(size_t chunk) const {
+            if (split_version != version || split_chunk != chunk) {
+                split_points.clear();
+                size_t index = 0;
+                for (Node* current = head; current; current = current->next, ++index) {
+                    if (index % chunk == 0) {
+                        split_points.push_back(current);
+                    }
+                }
+                split_version = version;
+                split_chunk = chunk;
+            }
+            return split_points;
+        }
+
+        // Раздаёт куски [splits[i], splits[i + 1]) потокам через общий счётчик.
+        // Первое исключение останавливает раздачу и пробрасывается после join
+        template <typename ChunkFunction>
+        void run_chunks(size_t threads, size_t chunk, ChunkFunction&& process) const {
+            const std::vector<Node*>& points = splits(std::max<size_t>(chunk, 1));
+            const size_t chunks = points.size();
+            if (threads == 0) {
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            }
+            threads = std::min(threads, chunks);
+
+            std::atomic<size_t> next_chunk{0};
+            std::atomic<bool> failed{false};
+            std::exception_ptr error;
+            std::mutex error_mutex;
+            auto worker = [&]() {
+                for (size_t i = next_chunk++; i < chunks && !failed; i = next_chunk++) {
+                    try {
+                        process(i, points[i], i + 1 < chunks ? points[i + 1] : nullptr);
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(error_mutex);
+                        if (!error) {
+                            error = std::current_exception();
+                        }
+                        failed = true;
+                    }
+                }
+            };
+
+            std::vector<std::thread> workers;
+            for (size_t t = 1; t < threads; ++t) {
+                try {
+                    workers.emplace_back(worker);
+                } catch (const std::system_error&) {
+                    break; // Потоков меньше, чем просили, - остальное доделают имеющиеся
+                }
+            }
+            worker();
+            for (auto& thread : workers) {
+                thread.join();
+            }
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        // splice перевешивает узлы без копирования, поэтому память узлов
+        // должна принадлежать одному ресурсу (do_is_equal)
+        void check_splice_source(const doubly_linked_list& other) const {
+            if (allocator != other.allocator) {
+                throw std::invalid_argument("splice between lists with different memory resources");
+            }
+        }
 
     public:
-        class iterator {
+        // Двунаправленный итератор; IsConst выбирает константный вариант.
+        // Итератор помнит свой список, поэтому из end() можно шагнуть назад
+        template <bool IsConst>
+        class basic_iterator {
             private:
-                Node* current;
-            
+                using list_pointer = std::conditional_t<IsConst, const doubly_linked_list*, doubly_linked_list*>;
+
+                Node* current{nullptr};
+                list_pointer owner{nullptr};
+                friend class doubly_linked_list;
+                friend class basic_iterator<!IsConst>;
+
             public:
-                using iterator_category = std::forward_iterator_tag;
+                using iterator_category = std::bidirectional_iterator_tag;
                 using value_type = T;
                 using difference_type = std::ptrdiff_t;
-                using pointer = T*;
-                using reference = T&;
-                explicit iterator(Node* node) : current(node) {}
+                using pointer = std::conditional_t<IsConst, const T*, T*>;
+                using reference = std::conditional_t<IsConst, const T&, T&>;
 
-                reference operator*() { return current->data; }
-                pointer operator->() { return &(current->data); }
+                basic_iterator() = default;
+                basic_iterator(Node* node, list_pointer list) : current(node), owner(list) {}
+                // Неконстантный итератор неявно приводится к константному
+                template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+                basic_iterator(const basic_iterator<OtherConst>& other) : current(other.current), owner(other.owner) {}
 
-                iterator& operator++() {
+                reference operator*() const { return current->data; }
+                pointer operator->() const { return &(current->data); }
+
+                basic_iterator& operator++() {
                     current = current->next;
                     return *this;
                 }
 
-                iterator operator++(int) {
-                    iterator temp = *this; // Сохраняем текущее состояние
+                basic_iterator operator++(int) {
+                    basic_iterator temp = *this; // Сохраняем текущее состояние
                     ++(*this); // Используем префиксный инкремент для продвижения итератора
                     return temp;
                 }
 
-                bool operator==(const iterator& other) const {
+                basic_iterator& operator--() {
+                    // Шаг назад из end() ведёт к последнему элементу
+                    current = current ? current->prev : owner->tail;
+                    return *this;
+                }
+
+                basic_iterator operator--(int) {
+                    basic_iterator temp = *this;
+                    --(*this);
+                    return temp;
+                }
+
+                template <bool OtherConst>
+                bool operator==(const basic_iterator<OtherConst>& other) const {
                     return current == other.current;
                 }
 
-                bool operator!=(const iterator& other) const {
+                template <bool OtherConst>
+                bool operator!=(const basic_iterator<OtherConst>& other) const {
                     return current != other.current;
                 }
         };
-        doubly_linked_list(std::pmr::memory_resource* mr) : allocator(mr),
-                                                            head(nullptr), 
-                                                            tail(nullptr), 
-                                                            list_size(0) {}  
+
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        using allocator_type = Allocator;
+
+        explicit doubly_linked_list(const allocator_type& alloc) : head(nullptr),
+                                                                   tail(nullptr),
+                                                                   list_size(0),
+                                                                   allocator(alloc) {}
+        doubly_linked_list(std::pmr::memory_resource* mr) requires is_pmr : doubly_linked_list(allocator_type(mr)) {}
+        doubly_linked_list() requires std::default_initializable<allocator_type> : doubly_linked_list(allocator_type()) {}
+
+        // Копирование по правилам pmr: копия без явного аллокатора получает
+        // ресурс по умолчанию (select_on_container_copy_construction)
+        doubly_linked_list(const doubly_linked_list& other)
+            : doubly_linked_list(other, std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator())) {}
+        doubly_linked_list(const doubly_linked_list& other, const allocator_type& alloc) : doubly_linked_list(alloc) {
+            link_range_from(nullptr, other.begin(), other.end());
+        }
+        // Перемещение за O(1): узлы переходят вместе с ресурсом
+        doubly_linked_list(doubly_linked_list&& other) noexcept : doubly_linked_list(other.get_allocator()) {
+            take_nodes(other);
+        }
+        // С другим ресурсом узлы забрать нельзя - элементы перемещаются по одному
+        doubly_linked_list(doubly_linked_list&& other, const allocator_type& alloc) : doubly_linked_list(alloc) {
+            if (allocator == other.allocator) {
+                take_nodes(other);
+            } else {
+                link_range_from(nullptr, std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+            }
+        }
+
+        // Присваивание не меняет ресурс списка (polymorphic_allocator не распространяется)
+        doubly_linked_list& operator=(const doubly_linked_list& other) {
+            if (this != &other) {
+                assign(other.begin(), other.end());
+            }
+            return *this;
+        }
+        doubly_linked_list& operator=(doubly_linked_list&& other) {
+            if (this == &other) {
+                return *this;
+            }
+            if (allocator == other.allocator) {
+                clear();
+                take_nodes(other);
+            } else {
+                assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                other.clear();
+            }
+            return *this;
+        }
+
+        // Обмен за O(1); списки с разными ресурсами обменять нельзя,
+        // так как узлы остались бы в чужом ресурсе
+        void swap(doubly_linked_list& other) {
+            check_splice_source(other);
+            std::swap(head, other.head);
+            std::swap(tail, other.tail);
+            std::swap(list_size, other.list_size);
+            ++version;
+            ++other.version;
+        }
+        friend void swap(doubly_linked_list& a, doubly_linked_list& b) {
+            a.swap(b);
+        }
+
+        allocator_type get_allocator() const {
+            return allocator_type(allocator);
+        }
+        // Конструкторы из диапазона: узлы выделяются пачкой, см. link_range_from
+        template <std::input_iterator InputIt>
+        doubly_linked_list(InputIt first, InputIt last, const allocator_type& alloc) : doubly_linked_list(alloc) {
+            link_range_from(nullptr, first, last);
+        }
+        doubly_linked_list(std::initializer_list<T> values, const allocator_type& alloc) : doubly_linked_list(alloc) {
+            link_range_from(nullptr, values.begin(), values.end());
+        }
         ~doubly_linked_list() {
             clear(); // Освобождаем все узлы
         }
 
         void push_back(const T& value) {
-            Node* new_node = allocator.allocate(1);
-            
-            std::allocator_traits<decltype(allocator)>::construct(allocator, new_node, value);
-            // Добавляем новый узел в конец списка
-            // ПРоверяем, пустой ли список
-            if (tail) {
-                tail->next = new_node;
-                new_node->prev = tail;
-                tail = new_node;
+            emplace_back(value);
+        };
+        void push_back(T&& value) {
+            emplace_back(std::move(value));
+        };
+        void push_front(const T& value) {
+            emplace_front(value);
+        };
+        void push_front(T&& value) {
+            emplace_front(std::move(value));
+        };
+
+        // Конструируют элемент прямо в узле, без промежуточного T
+        template <typename... Args>
+        T& emplace_back(Args&&... args) {
+            Node* new_node = create_node(std::forward<Args>(args)...);
+            link_before(nullptr, new_node);
+            return new_node->data;
+        };
+        template <typename... Args>
+        T& emplace_front(Args&&... args) {
+            Node* new_node = create_node(std::forward<Args>(args)...);
+            link_before(head, new_node);
+            return new_node->data;
+        };
+        // Вставляет элемент перед pos; end() - вставка в конец
+        template <typename... Args>
+        iterator emplace(const_iterator pos, Args&&... args) {
+            Node* new_node = create_node(std::forward<Args>(args)...);
+            link_before(pos.current, new_node);
+            return iterator(new_node, this);
+        };
+        iterator insert(const_iterator pos, const T& value) {
+            return emplace(pos, value);
+        };
+        iterator insert(const_iterator pos, T&& value) {
+            return emplace(pos, std::move(value));
+        };
+
+        // Вставляет [first, last) перед pos; возвращает итератор на первый
+        // вставленный элемент или pos, если диапазон пуст
+        template <std::input_iterator InputIt>
+        iterator insert(const_iterator pos, InputIt first, InputIt last) {
+            Node* inserted = link_range_from(pos.current, first, last);
+            return iterator(inserted ? inserted : pos.current, this);
+        };
+        iterator insert(const_iterator pos, std::initializer_list<T> values) {
+            return insert(pos, values.begin(), values.end());
+        };
+        template <std::ranges::input_range Range>
+        void append_range(Range&& range) {
+            link_range_from(nullptr, std::ranges::begin(range), std::ranges::end(range));
+        };
+        // Заменяет содержимое: существующие узлы переиспользуются присваиванием,
+        // лишние удаляются, недостающие добавляются пачкой
+        template <std::input_iterator InputIt>
+        void assign(InputIt first, InputIt last) {
+            Node* current = head;
+            for (; current && first != last; ++first) {
+                current->data = *first;
+                current = current->next;
             }
-            else {
-                head = new_node;
-                tail = new_node;
+            if (current) {
+                erase(const_iterator(current, this), end());
+            } else {
+                link_range_from(nullptr, first, last);
             }
-            ++list_size;
         };
-        void push_front(const T& value) {
-            Node* new_node = allocator.allocate(1);
-            std::allocator_traits<decltype(allocator)>::construct(allocator, new_node, value);
-            // Добавляем новый узел в начало списка
-            if (head) {
-                head->prev = new_node;
-                new_node->next = head;
-                head = new_node;
+        void assign(std::initializer_list<T> values) {
+            assign(values.begin(), values.end());
+        };
+
+        // Удаляет элемент в pos и возвращает итератор на следующий
+        iterator erase(const_iterator pos) {
+            Node* node = pos.current;
+            Node* next = node->next;
+            unlink_range(node, node, 1);
+            destroy_node(node);
+            return iterator(next, this);
+        };
+        // Удаляет полуинтервал [first, last)
+        iterator erase(const_iterator first, const_iterator last) {
+            while (first != last) {
+                first = erase(first);
             }
-            else {
-                head = new_node;
-                tail = new_node;
+            return iterator(last.current, this);
+        };
+        // Удаляет все элементы, для которых pred истинен; возвращает их число
+        template <typename Predicate>
+        size_t remove_if(Predicate pred) {
+            size_t removed = 0;
+            Node* current = head;
+            while (current) {
+                Node* next = current->next;
+                if (pred(current->data)) {
+                    unlink_range(current, current, 1);
+                    destroy_node(current);
+                    ++removed;
+                }
+                current = next;
             }
-            ++list_size;
+            return removed;
+        };
+
+        // Переносит все узлы other перед pos за O(1)
+        void splice(const_iterator pos, doubly_linked_list& other) {
+            check_splice_source(other);
+            if (&other == this || other.empty()) {
+                return;
+            }
+            Node* first = other.head;
+            Node* last = other.tail;
+            size_t count = other.list_size;
+            other.unlink_range(first, last, count);
+            link_range_before(pos.current, first, last, count);
+        };
+        void splice(const_iterator pos, doubly_linked_list&& other) {
+            splice(pos, other);
+        };
+        // Переносит один узел it из other перед pos за O(1)
+        void splice(const_iterator pos, doubly_linked_list& other, const_iterator it) {
+            check_splice_source(other);
+            Node* node = it.current;
+            if (&other == this && (node == pos.current || node->next == pos.current)) {
+                return; // Узел уже стоит на месте
+            }
+            other.unlink_range(node, node, 1);
+            link_range_before(pos.current, node, node, 1);
+        };
+        void splice(const_iterator pos, doubly_linked_list&& other, const_iterator it) {
+            splice(pos, other, it);
+        };
+        // Переносит [first, last) из other перед pos. Внутри одного списка -
+        // O(1); между списками нужно пересчитать размер, это O(длины диапазона)
+        void splice(const_iterator pos, doubly_linked_list& other, const_iterator first, const_iterator last) {
+            check_splice_source(other);
+            if (first == last) {
+                return;
+            }
+            Node* first_node = first.current;
+            Node* last_node = last.current ? last.current->prev : other.tail;
+            size_t count = 0;
+            if (&other != this) {
+                count = static_cast<size_t>(std::distance(first, last));
+            }
+            other.unlink_range(first_node, last_node, count);
+            link_range_before(pos.current, first_node, last_node, count);
+        };
+        void splice(const_iterator pos, doubly_linked_list&& other, const_iterator first, const_iterator last) {
+            splice(pos, other, first, last);
         };
         void pop_back() {
             if (!tail) {
@@ -116,6 +722,7 @@ class doubly_linked_list {
             // fixed_block_memory_resource::do_deallocate(...)
             allocator.deallocate(old_tail, 1);
             --list_size;
+            ++version;
         };
         void pop_front() {
             if (!head) {
@@ -133,7 +740,167 @@ class doubly_linked_list {
             std::allocator_traits<decltype(allocator)>::destroy(allocator, old_head);
             allocator.deallocate(old_head, 1);
             --list_size;
+            ++version;
+        };
+        // Сортировка слиянием снизу вверх: узлы только перевешиваются,
+        // память не выделяется. Устойчива. Если comp бросает, все элементы
+        // остаются в списке, но их порядок не определён
+        template <typename Compare = std::less<>>
+        void sort(Compare comp = Compare()) {
+            if (list_size < 2) {
+                return;
+            }
+            for (size_t width = 1; width < list_size; width *= 2) {
+                Node* rest = head;
+                Node* sorted_first = nullptr;
+                Node* sorted_last = nullptr;
+                while (rest) {
+                    Node* left = rest;
+                    Node* right = split_chain(left, width);
+                    rest = split_chain(right, width);
+                    Node* merged_first;
+                    Node* merged_last;
+                    try {
+                        merge_chains(left, right, comp, merged_first, merged_last);
+                    } catch (...) {
+                        append_chain(sorted_first, sorted_last, merged_first);
+                        append_chain(sorted_first, sorted_last, rest);
+                        head = sorted_first;
+                        relink_prev();
+                        throw;
+                    }
+                    if (sorted_last) {
+                        sorted_last->next = merged_first;
+                    } else {
+                        sorted_first = merged_first;
+                    }
+                    sorted_last = merged_last;
+                }
+                head = sorted_first;
+            }
+            relink_prev();
+        };
+
+        // Сливает отсортированный other в этот отсортированный список, other
+        // становится пустым. Ресурсы должны совпадать, как у splice
+        template <typename Compare = std::less<>>
+        void merge(doubly_linked_list& other, Compare comp = Compare()) {
+            check_splice_source(other);
+            if (&other == this || other.empty()) {
+                return;
+            }
+            Node* first;
+            Node* last;
+            Node* other_head = other.head;
+            list_size += other.list_size;
+            other.head = nullptr;
+            other.tail = nullptr;
+            other.list_size = 0;
+            ++other.version;
+            try {
+                merge_chains(head, other_head, comp, first, last);
+            } catch (...) {
+                head = first;
+                relink_prev();
+                throw;
+            }
+            head = first;
+            relink_prev();
+        };
+        template <typename Compare = std::less<>>
+        void merge(doubly_linked_list&& other, Compare comp = Compare()) {
+            merge(other, comp);
+        };
+
+        // Удаляет подряд идущие равные элементы, оставляя первый из них
+        template <typename BinaryPredicate = std::equal_to<>>
+        size_t unique(BinaryPredicate pred = BinaryPredicate()) {
+            size_t removed = 0;
+            Node* current = head;
+            while (current && current->next) {
+                Node* next = current->next;
+                if (pred(current->data, next->data)) {
+                    unlink_range(next, next, 1);
+                    destroy_node(next);
+                    ++removed;
+                } else {
+                    current = next;
+                }
+            }
+            return removed;
+        };
+
+        // Разворачивает список обменом указателей в каждом узле
+        void reverse() {
+            for (Node* current = head; current; current = current->prev) {
+                std::swap(current->prev, current->next);
+            }
+            std::swap(head, tail);
+            ++version;
+        };
+
+        // Последовательный обход по порядку с программной предвыборкой узлов
+        // streams независимыми курсорами. Полезен, когда узлы разбросаны по
+        // памяти (после переиспользования блоков или sort). Точки разбиения
+        // строятся обычным обходом при первом вызове после изменения списка
+        static constexpr size_t DEFAULT_PREFETCH_STREAMS{8};
+        static constexpr size_t MAX_PREFETCH_STREAMS{32};
+        static constexpr size_t PREFETCH_CHUNK{64};
+
+        template <typename Function>
+        void for_each_prefetched(Function f, size_t streams = DEFAULT_PREFETCH_STREAMS) {
+            prefetched_walk(f, streams);
+        };
+        template <typename Function>
+        void for_each_prefetched(Function f, size_t streams = DEFAULT_PREFETCH_STREAMS) const {
+            auto visit = [&f](const T& value) { f(value); };
+            prefetched_walk(visit, streams);
+        };
+
+        // Параллельный обход: список режется на куски по chunk узлов, куски
+        // разбираются threads потоками (0 - по числу ядер). Точки разбиения
+        // кэшируются, поэтому повторный обход неизменённого списка не проходит
+        // его последовательно. Структуру списка во время обхода менять нельзя,
+        // а одновременные вызовы на одном списке не допускаются
+        static constexpr size_t DEFAULT_PARALLEL_CHUNK{4096};
+
+        template <typename Function>
+        void parallel_for_each(Function f, size_t threads = 0, size_t chunk = DEFAULT_PARALLEL_CHUNK) {
+            run_chunks(threads, chunk, [&f](size_t, Node* first, Node* last) {
+                for (Node* current = first; current != last; current = current->next) {
+                    f(current->data);
+                }
+            });
         };
+
+        // Свёртка transform(x) операцией reduce. Частичные результаты кусков
+        // объединяются по порядку, поэтому reduce достаточно ассоциативности
+        template <typename U, typename BinaryOp, typename UnaryOp>
+        U parallel_transform_reduce(U init, BinaryOp reduce, UnaryOp transform,
+                                    size_t threads = 0, size_t chunk = DEFAULT_PARALLEL_CHUNK) const {
+            if (empty()) {
+                return init;
+            }
+            std::vector<std::optional<U>> partials(splits(std::max<size_t>(chunk, 1)).size());
+            run_chunks(threads, chunk, [&](size_t index, Node* first, Node* last) {
+                const T& first_value = first->data;
+                U accumulator = transform(first_value);
+                for (Node* current = first->next; current != last; current = current->next) {
+                    const T& value = current->data;
+                    accumulator = reduce(std::move(accumulator), transform(value));
+                }
+                partials[index].emplace(std::move(accumulator));
+            });
+            for (auto& partial : partials) {
+                init = reduce(std::move(init), std::move(*partial));
+            }
+            return init;
+        };
+        template <typename U, typename BinaryOp = std::plus<>>
+        U parallel_reduce(U init, BinaryOp reduce = BinaryOp(), size_t threads = 0, size_t chunk = DEFAULT_PARALLEL_CHUNK) const {
+            return parallel_transform_reduce(std::move(init), reduce, [](const T& value) -> const T& { return value; }, threads, chunk);
+        };
+
         size_t size() const {
             return list_size;
         };
@@ -145,6 +912,14 @@ class doubly_linked_list {
                 pop_front();
             }
         };
+        // Забывает все узлы без поштучного освобождения памяти. Память узлов
+        // возвращается разом, например fixed_block_memory_resource::release()
+        void discard() requires std::is_trivially_destructible_v<T> {
+            head = nullptr;
+            tail = nullptr;
+            list_size = 0;
+            ++version;
+        };
         void print_list() const {
             Node* current = head;
             while (current) {
@@ -153,6 +928,25 @@ class doubly_linked_list {
             }
             std::cout << std::endl;
         };
-        iterator begin() { return iterator(head);}
-        iterator end() { return iterator(nullptr); }
-};
\ No newline at end of file
+        iterator begin() { return iterator(head, this); }
+        iterator end() { return iterator(nullptr, this); }
+        const_iterator begin() const { return const_iterator(head, this); }
+        const_iterator end() const { return const_iterator(nullptr, this); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crbegin() const { return rbegin(); }
+        const_reverse_iterator crend() const { return rend(); }
+};
+
+// Пул и список, узлы которого выделяются из него без виртуальных вызовов:
+//     node_pool_for<int> pool;
+//     pooled_doubly_linked_list<int> list(&pool);
+template <typename T>
+using node_pool_for = typed_node_pool<sizeof(doubly_linked_list_node<T>), alignof(doubly_linked_list_node<T>)>;
+template <typename T>
+using pooled_doubly_linked_list = doubly_linked_list<T, typed_node_allocator<T, node_pool_for<T>>>;
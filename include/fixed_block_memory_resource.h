@@ -1,22 +1,265 @@
 #include <memory_resource>
 #include <list>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <vector>
+#include <string>
 #pragma once
 
 class fixed_block_memory_resource : public std::pmr::memory_resource {
+    public:
+        // Где хранятся метаданные блоков. Пул в файле всегда работает как in_pool
+        enum class metadata_placement {
+            heap,    // Список блоков, корзины и индекс в глобальной куче
+            in_pool  // Заголовки в начале блоков, корзины - через сами свободные блоки: без обращений к куче
+        };
+
+        // Откуда берётся память первой арены
+        enum class backing_store {
+            heap, // new char[]
+            mmap, // Анонимное отображение: страницы выделяются ядром при первом обращении
+            file  // Отображение файла options.file_path (MAP_SHARED): пул переживает перезапуск
+        };
+
+        // Большие страницы для backing_store::mmap
+        enum class huge_pages {
+            none,
+            advise,  // madvise(MADV_HUGEPAGE): прозрачные большие страницы, если ядро позволяет
+            required // MAP_HUGETLB: только заранее зарезервированные большие страницы
+        };
+
+        struct options {
+            metadata_placement metadata{metadata_placement::heap};
+
+            // Рост пула: при нехватке места к цепочке добавляется новая арена,
+            // а уже выделенные блоки остаются на своих адресах
+            bool growable{false};
+            double growth_factor{2.0}; // Во сколько раз новая арена больше предыдущей
+            size_t max_total_size{0}; // Предел суммарного размера арен; 0 - без предела
+            std::pmr::memory_resource* upstream{nullptr}; // Источник новых арен; nullptr - куча
+
+            backing_store backing{backing_store::heap};
+            huge_pages pages{huge_pages::none};
+            int numa_node{-1}; // Узел NUMA для страниц пула (mbind); -1 - политика по умолчанию
+            // Файл пула для backing_store::file. Существующий файл открывается
+            // заново, и его размер важнее переданного в конструктор
+            std::string file_path;
+        };
+
+        // Использование одной арены
+        struct arena_usage {
+            void* base{nullptr};
+            size_t size{0};
+            size_t used{0};
+        };
+
+        // Снимок статистики выделений. Счётчики обновляются, только если
+        // библиотека собрана с FIXED_BLOCK_STATS, иначе остаются нулями
+        struct statistics {
+            static constexpr size_t HISTOGRAM_BUCKETS{6};
+
+            size_t allocations{0};
+            size_t deallocations{0};
+            size_t reused_allocations{0}; // Выданы из корзин свободных блоков
+            size_t failed_allocations{0}; // Завершились std::bad_alloc
+            size_t live_bytes{0}; // Занято блоками сейчас
+            size_t peak_live_bytes{0};
+            size_t padding_bytes{0}; // Потери на округление размеров живых блоков
+            // Сколько свободных блоков просмотрено при поиске: 0, 1, 2-3, 4-7, 8-15, 16+
+            std::array<size_t, HISTOGRAM_BUCKETS> search_length_histogram{};
+
+            double reuse_hit_rate() const;
+            std::string to_json() const;
+        };
+
     private:
+        struct MemoryBlock;
+        using block_iterator = std::pmr::list<MemoryBlock>::iterator;
+
         struct MemoryBlock {
             void* ptr{nullptr};
             size_t size{0};
             bool is_free{true};
+            // Соседи в корзине, пока блок свободен; blocks.end() - нет соседа.
+            // Связи хранятся в самом блоке, поэтому освобождение ничего не выделяет
+            block_iterator prev_free{};
+            block_iterator next_free{};
+        };
+
+        // Корзина свободных блоков - двусвязный список через prev_free/next_free
+        struct free_bin {
+            block_iterator first;
+            block_iterator last;
+        };
+        // Точные корзины для размеров до SMALL_BINS * GRANULE, дальше - по
+        // степеням двойки. Непустые корзины отмечены битами в bin_mask
+        static constexpr size_t SMALL_BINS{64};
+        static constexpr size_t BIN_COUNT{128};
+        static size_t bin_for(size_t size);
+
+        // Гранула: размеры блоков кратны ей, а их начала выровнены по ней,
+        // поэтому соседние блоки в blocks физически примыкают друг к другу
+        static constexpr size_t GRANULE{alignof(std::max_align_t)};
+
+        // Режим in_pool: каждый блок - участок (chunk) пула с заголовком перед
+        // данными. size - размер участка вместе с заголовком и флагом PREV_IN_USE
+        // (занят ли предыдущий участок). prev_size - размер предыдущего участка;
+        // он записан, только пока тот свободен, а у занятого эти 8 байт - конец
+        // его данных. Поэтому на заголовок занятого блока уходит 8 байт
+        struct ChunkHeader {
+            std::uint64_t prev_size;
+            std::uint64_t size;
+        };
+        // Свободный участок хранит в себе связи корзины - смещения соседей от memory_pool
+        struct FreeChunk {
+            ChunkHeader header;
+            std::uint64_t next;
+            std::uint64_t prev;
+        };
+        static constexpr std::uint64_t PREV_IN_USE{1};
+        static constexpr std::uint64_t NO_CHUNK{~std::uint64_t{0}};
+        static constexpr size_t MIN_CHUNK{sizeof(FreeChunk)};
+        // Корзины свободных участков, разбитые так же, как free_bins
+        struct ChunkBins {
+            std::array<std::uint64_t, BIN_COUNT> heads;
+            std::array<std::uint64_t, BIN_COUNT / 64> mask;
+            std::uint64_t free_bytes;
+        };
+
+        // Арена - непрерывный участок памяти, из "хвоста" которого выделяются блоки
+        struct Arena {
+            char* base{nullptr};
+            size_t size{0};
+            size_t used{0}; // Количество использованных байт
+        };
+
+        // Заголовок файла пула: всё, что нужно для открытия пула заново.
+        // Границы блоков записаны в их заголовках, а корзины - здесь, поэтому
+        // блоки, освобождённые в прошлых сеансах, снова доступны без обхода
+        struct FileHeader {
+            std::uint64_t magic;
+            std::uint64_t pool_size;
+            std::uint64_t used; // "Хвост" пула, обновляется при каждом его сдвиге
+            std::uint64_t root; // Смещение корневого объекта + 1; 0 - корня нет
+            std::uint32_t version;
+            std::uint32_t clean; // 1, если файл закрыт деструктором
+            ChunkBins bins;
+        };
+        // Пул в файле начинается сразу за заголовком, с границы кэш-линии
+        static constexpr size_t FILE_HEADER_SIZE{(sizeof(FileHeader) + 63) & ~size_t{63}};
+
+        // Память первой арены: куча, анонимное отображение mmap или файл
+        struct PoolStorage {
+            char* base{nullptr};
+            size_t size{0}; // Размер памяти под пул и метаданные
+            size_t mapped_size{0}; // Не 0, если память получена через mmap
+            FileHeader* header{nullptr}; // Начало отображения для backing_store::file
+            int fd{-1};
+            bool opened_cleanly{true};
+
+            PoolStorage(size_t pool_bytes, const options& opts);
+            // Открывает или создаёт файл пула и отображает его с MAP_SHARED
+            void map_file(const options& opts);
+            PoolStorage(const PoolStorage&) = delete;
+            PoolStorage& operator=(const PoolStorage&) = delete;
+            ~PoolStorage();
+        };
+
+        // Цепочка арен. Первая арена - memory_pool, остальные берутся у upstream
+        // и возвращаются ему при разрушении цепочки
+        struct ArenaChain {
+            std::pmr::memory_resource* upstream{nullptr};
+            std::vector<Arena> arenas;
+
+            ArenaChain() = default;
+            ArenaChain(const ArenaChain&) = delete;
+            ArenaChain& operator=(const ArenaChain&) = delete;
+            ~ArenaChain();
         };
 
         static constexpr size_t BUFFER_SIZE{1024 * 1024}; // 1 MB
+        // Пул и арены объявлены первыми: они освобождаются после метаданных,
+        // которые могут в них храниться
+        PoolStorage pool_storage;
+        ArenaChain arena_chain;
         char* memory_pool;
-        size_t pool_size; // Размер всего пула
-        size_t used_bytes{0}; // Количество использованных байт
-        std::list<MemoryBlock> blocks;
+        size_t pool_size;
+        options settings;
+        statistics stats;
+        // Метаданные режима heap выделяются из metadata_pool, который отдаёт
+        // всю память разом в release(). В режиме in_pool контейнеры пусты
+        std::pmr::unsynchronized_pool_resource metadata_pool;
+        std::pmr::list<MemoryBlock> blocks;
+        // Сегрегированные по размеру корзины свободных блоков для поиска
+        // наиболее подходящего (best-fit) блока
+        std::array<free_bin, BIN_COUNT> free_bins;
+        std::array<std::uint64_t, BIN_COUNT / 64> bin_mask{};
+        size_t free_block_bytes{0}; // Суммарный размер блоков в корзинах
+        // Индекс блоков по адресу: do_deallocate находит метаданные блока за O(1)
+        std::pmr::unordered_map<void*, block_iterator> block_index;
+        // Корзины участков: own_chunk_bins или корзины из заголовка файла
+        ChunkBins own_chunk_bins;
+        ChunkBins* chunk_bins;
         size_t block_size;
 
+        // Работа с корзинами свободных блоков; ничего не выделяют и не бросают
+        void reset_bins();
+        void link_free(block_iterator it) noexcept;
+        void unlink_free(block_iterator it) noexcept;
+        // Первая непустая корзина с номером не меньше bin; BIN_COUNT, если таких нет
+        static size_t next_bin(const std::array<std::uint64_t, BIN_COUNT / 64>& mask, size_t bin);
+        // Отрезает от блока первые size байт, остаток становится свободным.
+        // При нехватке памяти под метаданные блок остаётся прежним
+        void split_block(block_iterator it, size_t size);
+        // Добавляет занятый блок в конец blocks и в индекс; при ошибке ничего не меняет
+        block_iterator append_block(void* ptr, size_t size);
+        // Выделение из "хвоста" последней арены
+        void* allocate_from_tail(size_t size, size_t alignment);
+        // Добавляет арену, вмещающую min_size байт
+        void add_arena(size_t min_size);
+        // Лежат ли блоки вплотную друг к другу в одной арене
+        bool adjacent(const MemoryBlock& first, const MemoryBlock& second) const;
+        // Возвращает занятый блок в корзины, сливая его со свободными соседями
+        void release_block(block_iterator it);
+        // Сохраняет "хвост" первой арены в заголовке файла
+        void store_tail() {
+            if (pool_storage.header) {
+                pool_storage.header->used = arena_chain.arenas.front().used;
+            }
+        }
+
+        // Участки режима in_pool
+        bool in_block() const {
+            return settings.metadata == metadata_placement::in_pool || settings.backing == backing_store::file;
+        }
+        // Размер участка под блок из bytes байт
+        static constexpr size_t chunk_size(size_t bytes) {
+            size_t size = ((bytes == 0 ? 1 : bytes) + sizeof(std::uint64_t) + GRANULE - 1) & ~(GRANULE - 1);
+            return size < MIN_CHUNK ? MIN_CHUNK : size;
+        }
+        // Место арены под участки: в конце остаётся барьер размером в заголовок
+        size_t chunk_limit(const Arena& arena) const { return arena.size - sizeof(ChunkHeader); }
+        ChunkHeader* chunk_at(std::uint64_t offset) const;
+        std::uint64_t chunk_offset(const ChunkHeader* chunk) const;
+        static ChunkHeader* chunk_after(ChunkHeader* chunk, size_t size);
+        // Участок становится свободным: пишет его размер в prev_size следующего,
+        // снимает у следующего PREV_IN_USE и кладёт участок в корзину
+        void link_chunk(ChunkHeader* chunk, size_t size) noexcept;
+        void unlink_chunk(ChunkHeader* chunk) noexcept;
+        // Отрезает от свободного (уже вынутого из корзины) участка первые size
+        // байт и отмечает их занятыми; остаток возвращается в корзины
+        void* take_chunk(ChunkHeader* chunk, size_t size) noexcept;
+        void* allocate_chunk(size_t bytes, size_t alignment);
+        void* allocate_chunk_from_tail(size_t size, size_t alignment);
+        void release_chunk(void* p, size_t bytes);
+        // Арена, содержащая адрес; nullptr, если такой нет
+        Arena* arena_of(const void* p);
+
+        // Учёт успешного выделения в статистике
+        void record_allocation(size_t bytes, size_t size, size_t searched, bool reused);
+
     protected:
         // Аллкатор вызывает эти методы внутри себя
         // do_allocate выделяет память из memory_pool под заданные размеры и выравнивание
@@ -29,6 +272,7 @@ class fixed_block_memory_resource : public std::pmr::memory_resource {
     public:
         // Конструктор и деструктор
         explicit fixed_block_memory_resource(size_t size = BUFFER_SIZE);
+        fixed_block_memory_resource(size_t size, const options& opts);
         ~fixed_block_memory_resource();
 
         // Запрет копирования
@@ -38,6 +282,40 @@ class fixed_block_memory_resource : public std::pmr::memory_resource {
         // Статистика для отладки
         size_t get_used_memory() const;
         size_t get_free_memory() const;
+        // Доля свободной памяти, недоступной для одного максимального запроса:
+        // 1 - (наибольший свободный участок / вся свободная память)
+        double get_fragmentation() const;
+        // Принадлежит ли адрес одной из арен этого ресурса
+        bool owns(const void* p) const;
+        // Использование памяти по аренам, начиная с первой
+        std::vector<arena_usage> get_arena_usage() const;
+        statistics get_statistics() const;
+
+        // Выделяет count блоков по bytes байт одним куском из "хвоста" пула, без
+        // поиска по корзинам. Блоки идут подряд с шагом block_stride(bytes), и
+        // каждый освобождается отдельно через deallocate(p, bytes, alignment).
+        // alignment не больше alignof(std::max_align_t)
+        void* allocate_contiguous(size_t bytes, size_t alignment, size_t count);
+        // Расстояние между соседними блоками allocate_contiguous; в режиме
+        // in_pool включает заголовок блока
+        size_t block_stride(size_t bytes) const {
+            return in_block() ? chunk_size(bytes) : ((bytes == 0 ? 1 : bytes) + GRANULE - 1) & ~(GRANULE - 1);
+        }
+
+        // Освобождает все блоки разом, как monotonic_buffer_resource::release(),
+        // дополнительные арены возвращаются upstream. Узлы метаданных не
+        // обходятся: metadata_pool сбрасывается целиком, а контейнеры
+        // создаются заново. Указатели, выданные ранее, становятся недействительными
+        void release();
+
+        // Только для backing_store::file. Корень - смещение объекта в пуле,
+        // по которому его находят после повторного открытия файла
+        void set_root(const void* p);
+        void* get_root() const;
+        // Сбрасывает отображение на диск (msync); без файла ничего не делает
+        void flush();
+        // false, если прошлый сеанс с файлом завершился без деструктора
+        bool opened_cleanly() const;
 
         void print_allocated_blocks() const;
-};
\ No newline at end of file
+};
@@ -0,0 +1,306 @@
+#pragma once
+#include "fixed_block_memory_resource.h"
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Двусвязный список, узлы которого связаны 32-битными смещениями от начала
+// непрерывной области памяти, а не указателями. Все узлы обязаны лежать в
+// этой области (например, в первой арене fixed_block_memory_resource), зато
+// связи узла занимают 8 байт вместо 16: узел offset_linked_list<int> -
+// 12 байт против 24 у doubly_linked_list<int>.
+// Голова, хвост и размер тоже хранятся в области (control_block), поэтому
+// список целиком описывается смещениями и не зависит от адреса отображения:
+// к нему можно присоединиться заново по control_offset(), например после
+// повторного открытия файла пула (backing_store::file)
+template <typename T>
+class offset_linked_list {
+    public:
+        using offset_type = std::uint32_t;
+
+        // Управляющий блок списка внутри области
+        struct control_block {
+            offset_type head{0};
+            offset_type tail{0};
+            std::uint64_t size{0};
+        };
+
+    private:
+        struct Node {
+            offset_type prev{0};
+            offset_type next{0};
+            T data;
+            template <typename... Args>
+            Node(Args&&... args) : data(std::forward<Args>(args)...) {}
+        };
+
+        char* base; // Начало области, от которого считаются смещения
+        size_t region_size;
+        control_block* control;
+        std::pmr::polymorphic_allocator<Node> allocator;
+
+        // Смещение хранится со сдвигом на 1: 0 означает "нет узла"
+        Node* node_at(offset_type offset) const {
+            return offset ? reinterpret_cast<Node*>(base + offset - 1) : nullptr;
+        }
+        offset_type offset_of(const void* p) const {
+            return p ? static_cast<offset_type>(static_cast<const char*>(p) - base + 1) : 0;
+        }
+        bool in_region(const void* p, size_t bytes) const {
+            const char* address = static_cast<const char*>(p);
+            return address >= base && address + bytes <= base + region_size;
+        }
+
+        template <typename U, typename... Args>
+        U* allocate_in_region(Args&&... args) {
+            std::pmr::polymorphic_allocator<U> object_allocator(allocator.resource());
+            U* object = object_allocator.allocate(1);
+            if (!in_region(object, sizeof(U))) {
+                // Ресурс выдал память вне области - смещение не поместится в связь
+                object_allocator.deallocate(object, 1);
+                throw std::bad_alloc();
+            }
+            try {
+                std::construct_at(object, std::forward<Args>(args)...);
+            } catch (...) {
+                object_allocator.deallocate(object, 1);
+                throw;
+            }
+            return object;
+        }
+
+        void destroy_node(Node* node) {
+            std::destroy_at(node);
+            allocator.deallocate(node, 1);
+        }
+
+        void link_before(Node* pos, Node* node) {
+            Node* prev = pos ? node_at(pos->prev) : node_at(control->tail);
+            offset_type node_offset = offset_of(node);
+            node->prev = offset_of(prev);
+            node->next = offset_of(pos);
+            if (prev) {
+                prev->next = node_offset;
+            } else {
+                control->head = node_offset;
+            }
+            if (pos) {
+                pos->prev = node_offset;
+            } else {
+                control->tail = node_offset;
+            }
+            ++control->size;
+        }
+
+        void unlink(Node* node) {
+            Node* prev = node_at(node->prev);
+            Node* next = node_at(node->next);
+            if (prev) {
+                prev->next = node->next;
+            } else {
+                control->head = node->next;
+            }
+            if (next) {
+                next->prev = node->prev;
+            } else {
+                control->tail = node->prev;
+            }
+            --control->size;
+        }
+
+        static fixed_block_memory_resource::arena_usage first_arena(fixed_block_memory_resource& mr) {
+            return mr.get_arena_usage().front();
+        }
+
+    public:
+        template <bool IsConst>
+        class basic_iterator {
+            private:
+                using list_pointer = std::conditional_t<IsConst, const offset_linked_list*, offset_linked_list*>;
+
+                Node* current{nullptr};
+                list_pointer owner{nullptr};
+                friend class offset_linked_list;
+                friend class basic_iterator<!IsConst>;
+
+            public:
+                using iterator_category = std::bidirectional_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = std::conditional_t<IsConst, const T*, T*>;
+                using reference = std::conditional_t<IsConst, const T&, T&>;
+
+                basic_iterator() = default;
+                basic_iterator(Node* node, list_pointer list) : current(node), owner(list) {}
+                template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+                basic_iterator(const basic_iterator<OtherConst>& other) : current(other.current), owner(other.owner) {}
+
+                reference operator*() const { return current->data; }
+                pointer operator->() const { return &(current->data); }
+
+                basic_iterator& operator++() {
+                    current = owner->node_at(current->next);
+                    return *this;
+                }
+                basic_iterator operator++(int) {
+                    basic_iterator temp = *this;
+                    ++(*this);
+                    return temp;
+                }
+                basic_iterator& operator--() {
+                    // Шаг назад из end() ведёт к последнему элементу
+                    current = owner->node_at(current ? current->prev : owner->control->tail);
+                    return *this;
+                }
+                basic_iterator operator--(int) {
+                    basic_iterator temp = *this;
+                    --(*this);
+                    return temp;
+                }
+
+                template <bool OtherConst>
+                bool operator==(const basic_iterator<OtherConst>& other) const {
+                    return current == other.current;
+                }
+                template <bool OtherConst>
+                bool operator!=(const basic_iterator<OtherConst>& other) const {
+                    return current != other.current;
+                }
+        };
+
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        // Область [region, region + size) - память, из которой mr выдаёт блоки
+        offset_linked_list(std::pmr::memory_resource* mr, void* region, size_t size)
+            : base(static_cast<char*>(region)), region_size(size), control(nullptr), allocator(mr) {
+            if (size >= std::numeric_limits<offset_type>::max()) {
+                throw std::invalid_argument("Region is too large for 32-bit offsets");
+            }
+            control = allocate_in_region<control_block>();
+        }
+        // Область - первая арена пула; блоки из дополнительных арен отвергаются
+        explicit offset_linked_list(fixed_block_memory_resource& mr)
+            : offset_linked_list(&mr, first_arena(mr).base, first_arena(mr).size) {}
+        // Присоединяется к уже существующему в области списку
+        offset_linked_list(std::pmr::memory_resource* mr, void* region, size_t size, offset_type control_offset)
+            : base(static_cast<char*>(region)), region_size(size), control(nullptr), allocator(mr) {
+            if (size >= std::numeric_limits<offset_type>::max()) {
+                throw std::invalid_argument("Region is too large for 32-bit offsets");
+            }
+            if (!in_region(base + control_offset, sizeof(control_block))) {
+                throw std::invalid_argument("Control block is outside the region");
+            }
+            control = reinterpret_cast<control_block*>(base + control_offset);
+        }
+        offset_linked_list(fixed_block_memory_resource& mr, offset_type control_offset)
+            : offset_linked_list(&mr, first_arena(mr).base, first_arena(mr).size, control_offset) {}
+        ~offset_linked_list() {
+            if (!control) {
+                return; // Список отсоединён и остаётся в области
+            }
+            clear();
+            std::pmr::polymorphic_allocator<control_block>(allocator.resource()).deallocate(control, 1);
+        }
+
+        offset_linked_list(const offset_linked_list&) = delete;
+        offset_linked_list& operator=(const offset_linked_list&) = delete;
+
+        void push_back(const T& value) {
+            emplace_back(value);
+        };
+        void push_back(T&& value) {
+            emplace_back(std::move(value));
+        };
+        void push_front(const T& value) {
+            emplace_front(value);
+        };
+        void push_front(T&& value) {
+            emplace_front(std::move(value));
+        };
+        template <typename... Args>
+        T& emplace_back(Args&&... args) {
+            Node* node = allocate_in_region<Node>(std::forward<Args>(args)...);
+            link_before(nullptr, node);
+            return node->data;
+        };
+        template <typename... Args>
+        T& emplace_front(Args&&... args) {
+            Node* node = allocate_in_region<Node>(std::forward<Args>(args)...);
+            link_before(node_at(control->head), node);
+            return node->data;
+        };
+
+        void pop_back() {
+            if (!control->tail) {
+                throw std::out_of_range("List is empty");
+            }
+            Node* node = node_at(control->tail);
+            unlink(node);
+            destroy_node(node);
+        };
+        void pop_front() {
+            if (!control->head) {
+                throw std::out_of_range("List is empty");
+            }
+            Node* node = node_at(control->head);
+            unlink(node);
+            destroy_node(node);
+        };
+
+        size_t size() const {
+            return static_cast<size_t>(control->size);
+        };
+        bool empty() const {
+            return control->size == 0;
+        };
+        void clear() {
+            while (!empty()) {
+                pop_front();
+            }
+        };
+        void print_list() const {
+            for (const T& value : *this) {
+                std::cout << value << " ";
+            }
+            std::cout << std::endl;
+        };
+
+        // Смещение управляющего блока от начала области в байтах
+        offset_type control_offset() const {
+            return offset_of(control) - 1;
+        }
+        // Отсоединяет объект от списка: узлы остаются в области, деструктор
+        // их не освобождает, а другие методы вызывать больше нельзя
+        offset_type detach() {
+            offset_type offset = control_offset();
+            control = nullptr;
+            return offset;
+        }
+        static constexpr size_t node_size() {
+            return sizeof(Node);
+        }
+
+        iterator begin() { return iterator(node_at(control->head), this); }
+        iterator end() { return iterator(nullptr, this); }
+        const_iterator begin() const { return const_iterator(node_at(control->head), this); }
+        const_iterator end() const { return const_iterator(nullptr, this); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crbegin() const { return rbegin(); }
+        const_reverse_iterator crend() const { return rend(); }
+};
@@ -0,0 +1,76 @@
+#pragma once
+#include "fixed_block_memory_resource.h"
+#include "offset_linked_list.h"
+#include <cstddef>
+#include <string>
+#include <type_traits>
+
+// Список, хранящийся в файле пула (backing_store::file). Связи узлов -
+// смещения от начала пула (offset_linked_list), а управляющий блок списка
+// записан корнем пула, поэтому повторное открытие файла - это mmap и
+// чтение заголовка, O(1) без десериализации, по любому адресу отображения.
+// Элементы копируются в файл как есть, поэтому T тривиально копируемый.
+//
+// Согласованность при сбоях:
+// - при падении процесса все выполненные записи остаются в страничном кэше
+//   и попадают в файл; если падение пришлось на середину push/pop, список
+//   может остаться связанным наполовину. Такой сеанс виден по
+//   opened_cleanly() == false, и список нужно проверить или построить заново;
+// - при отключении питания на диске гарантированно только то, что было до
+//   последнего flush(), и без порядка между страницами; flush() стоит
+//   вызывать в точках, где список согласован
+template <typename T>
+class persistent_list {
+    static_assert(std::is_trivially_copyable_v<T>, "Persistent list elements must be trivially copyable");
+
+    private:
+        fixed_block_memory_resource resource;
+        offset_linked_list<T> items;
+
+        static fixed_block_memory_resource::options file_options(const std::string& path) {
+            fixed_block_memory_resource::options opts;
+            opts.backing = fixed_block_memory_resource::backing_store::file;
+            opts.file_path = path;
+            return opts;
+        }
+        // Присоединяется к списку из корня пула или создаёт новый
+        static offset_linked_list<T> open_items(fixed_block_memory_resource& mr) {
+            auto* root = static_cast<char*>(mr.get_root());
+            auto* base = static_cast<char*>(mr.get_arena_usage().front().base);
+            return root ? offset_linked_list<T>(mr, static_cast<typename offset_linked_list<T>::offset_type>(root - base))
+                        : offset_linked_list<T>(mr);
+        }
+
+    public:
+        // Открывает файл path или создаёт его с пулом на size байт
+        persistent_list(const std::string& path, size_t size)
+            : resource(size, file_options(path)), items(open_items(resource)) {
+            if (!resource.get_root()) {
+                auto* base = static_cast<char*>(resource.get_arena_usage().front().base);
+                resource.set_root(base + items.control_offset());
+            }
+        }
+        ~persistent_list() {
+            items.detach(); // Узлы остаются в файле
+        }
+
+        persistent_list(const persistent_list&) = delete;
+        persistent_list& operator=(const persistent_list&) = delete;
+
+        offset_linked_list<T>& list() {
+            return items;
+        }
+        const offset_linked_list<T>& list() const {
+            return items;
+        }
+        fixed_block_memory_resource& memory_resource() {
+            return resource;
+        }
+
+        void flush() {
+            resource.flush();
+        }
+        bool opened_cleanly() const {
+            return resource.opened_cleanly();
+        }
+};
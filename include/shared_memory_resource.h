@@ -0,0 +1,79 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <sys/types.h>
+#pragma once
+
+// memory_resource в сегменте общей памяти POSIX для обмена списками между
+// процессами. Сегмент создаётся по имени (shm_open) или анонимно
+// (memfd_create, наследуется через fork), а всё состояние ресурса - заголовок,
+// списки свободных блоков и межпроцессный мьютекс - лежит в самом сегменте
+// и ссылается на блоки смещениями от его начала. Поэтому каждый процесс может
+// отобразить сегмент по своему адресу и выделять память наравне с остальными.
+// Как и у fixed_block_memory_resource, блоки кратны грануле и берутся из
+// "хвоста" сегмента; освобождённые блоки хранятся в корзинах по размеру.
+// Перед каждым блоком лежит заголовок в одну гранулу с его размером, размером
+// соседа и признаком занятости: повторное освобождение отвергается, а
+// свободные соседи сливаются, как в fixed_block_memory_resource::release_block.
+// Объекты в сегменте тоже должны ссылаться друг на друга смещениями,
+// например offset_linked_list с областью [base(), base() + size())
+class shared_memory_resource : public std::pmr::memory_resource {
+    private:
+        struct SegmentHeader;
+
+        static constexpr size_t GRANULE{alignof(std::max_align_t)};
+        // Блоки начинаются за заголовком, с границы кэш-линии
+        static const size_t POOL_OFFSET;
+
+        char* segment;
+        size_t segment_size;
+        std::string name; // Пусто для анонимного сегмента
+        pid_t creator; // Только создавший процесс удаляет имя сегмента
+
+        SegmentHeader* header() const {
+            return reinterpret_cast<SegmentHeader*>(segment);
+        }
+        // Отображает сегмент из fd; при создании задаёт размер и инициализирует заголовок
+        void map_segment(int fd, size_t size, bool create);
+        // Работа с корзинами; смещения - начала заголовков блоков.
+        // Все методы ниже вызываются под мьютексом сегмента
+        std::uint64_t& bin_of(std::uint64_t size);
+        void push_free(std::uint64_t offset, std::uint64_t size);
+        void unlink_free(std::uint64_t offset);
+        // Записывает размер предыдущего блока в заголовок блока по offset
+        // или, если offset - "хвост", в заголовок сегмента
+        void set_prev_size(std::uint64_t offset, std::uint64_t size);
+        // Помечает свободный блок занятым, отрезая лишний остаток
+        void* take_block(std::uint64_t offset, std::uint64_t size);
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    public:
+        // Создаёт именованный сегмент; имя вида "/name", сегмент не должен существовать
+        shared_memory_resource(const std::string& segment_name, size_t size);
+        // Открывает именованный сегмент, созданный другим процессом
+        explicit shared_memory_resource(const std::string& segment_name);
+        // Создаёт анонимный сегмент: его видят только процессы, порождённые fork
+        explicit shared_memory_resource(size_t size);
+        // Отображение закрывается; создатель именованного сегмента удаляет его имя,
+        // а память живёт, пока сегмент отображён хотя бы одним процессом
+        ~shared_memory_resource();
+
+        shared_memory_resource(const shared_memory_resource&) = delete;
+        shared_memory_resource& operator=(const shared_memory_resource&) = delete;
+
+        // Начало и размер сегмента: область для смещений
+        void* base() const { return segment; }
+        size_t size() const { return segment_size; }
+        // Занято "хвостом" сегмента, включая заголовок
+        size_t get_used_memory() const;
+        bool owns(const void* p) const;
+
+        // Корень - объект, с которого другие процессы начинают обход сегмента
+        void set_root(const void* p);
+        void* get_root() const;
+};
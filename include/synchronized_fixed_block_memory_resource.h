@@ -0,0 +1,93 @@
+#include "fixed_block_memory_resource.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+#pragma once
+
+// Потокобезопасный вариант fixed_block_memory_resource.
+// Общий пул защищён мьютексом, а освобождённые блоки сначала попадают
+// в "магазины" (кэши свободных блоков) своего потока. Магазины потока
+// принадлежат только ему, поэтому allocate/deallocate блока из магазина
+// не захватывают ни одного мьютекса; общий мьютекс нужен лишь для
+// пополнения и опустошения магазина по MAGAZINE_CAPACITY / 2 блоков.
+class synchronized_fixed_block_memory_resource : public std::pmr::memory_resource {
+    private:
+        static constexpr size_t MAGAZINE_CAPACITY{32}; // Блоков в одном магазине
+        static constexpr size_t MAX_CACHED_SIZE{1024}; // Более крупные блоки не кэшируются
+
+        // Магазин свободных блоков одного класса размеров
+        struct Magazine {
+            size_t size{0};
+            size_t alignment{0};
+            size_t count{0};
+            std::array<void*, MAGAZINE_CAPACITY> blocks{};
+        };
+
+        // Магазины одного потока для одного ресурса. Создаются при первом
+        // обращении потока к ресурсу и возвращают блоки в пул при завершении потока
+        struct alignas(64) ThreadCache {
+            // Ресурс-владелец; nullptr после его разрушения. Меняется под registry_lock()
+            synchronized_fixed_block_memory_resource* owner{nullptr};
+            std::uint64_t owner_id{0};
+            std::vector<Magazine> magazines;
+            // Другой поток не смог выделить память: магазины нужно вернуть в пул
+            std::atomic<bool> drain_requested{false};
+        };
+        // Кэши потока по ресурсам; определён в .cpp как thread_local
+        struct ThreadCacheSet;
+
+        // Метка в первых байтах блока, лежащего в магазине или возвращённого
+        // из магазина в пул. Выдаваемые блоки метку стирают, поэтому метка в
+        // освобождаемом блоке означает повторное освобождение из любого потока
+        static constexpr std::uint64_t FREED_TAG{0x44454546424C4B35ULL};
+
+        fixed_block_memory_resource central;
+        mutable std::mutex central_lock;
+        const std::uint64_t id; // Отличает ресурсы, созданные по одному адресу
+        std::vector<ThreadCache*> thread_caches; // Под registry_lock()
+
+        // Общий мьютекс связей ресурсов с кэшами потоков: захватывается
+        // только вне быстрого пути и всегда до central_lock
+        static std::mutex& registry_lock();
+        // Кэш текущего потока для этого ресурса
+        ThreadCache& local_cache();
+        static Magazine& find_magazine(ThreadCache& cache, size_t bytes, size_t alignment);
+        void* allocate_cached(size_t bytes, size_t alignment);
+        // Возвращает блоки магазинов кэша в общий пул; вызывается под central_lock
+        void flush_cache(ThreadCache& cache);
+        // Возвращает в пул магазины текущего потока и просит об этом остальные
+        void drain_caches();
+
+        void mark_freed(void* p) const;
+        void clear_mark(void* p) const;
+        bool is_marked(const void* p) const;
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        // Указатели вне пула или не с границы блока отвергаются сразу, как и
+        // повторное освобождение блока, лежащего в магазине любого потока
+        // или уже возвращённого из магазина в пул
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    public:
+        explicit synchronized_fixed_block_memory_resource(size_t size = 1024 * 1024);
+        // Кэши потоков, ещё работающих с ресурсом, отвязываются от него
+        ~synchronized_fixed_block_memory_resource();
+
+        // Запрет копирования
+        synchronized_fixed_block_memory_resource(const synchronized_fixed_block_memory_resource&) = delete;
+        synchronized_fixed_block_memory_resource& operator=(const synchronized_fixed_block_memory_resource&) = delete;
+
+        // Освобождает все блоки разом, очищая и магазины всех потоков.
+        // Не должен вызываться одновременно с выделением памяти
+        void release();
+
+        // Статистика общего пула: блоки в магазинах считаются занятыми
+        size_t get_used_memory() const;
+        size_t get_free_memory() const;
+        fixed_block_memory_resource::statistics get_statistics() const;
+};
@@ -0,0 +1,164 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+
+// Пул узлов одного размера и выравнивания, известных на этапе компиляции.
+// allocate_node/deallocate_node - невиртуальные встраиваемые операции над
+// интрузивным списком свободных слотов. Память берётся у upstream кусками,
+// которые удваиваются, и возвращается только в release() или деструкторе.
+// Как memory_resource пул обслуживает запросы не больше Size/Align из слотов,
+// а остальные передаёт upstream
+template <size_t Size, size_t Align>
+class typed_node_pool : public std::pmr::memory_resource {
+    static_assert(Size > 0, "Node size must be positive");
+    static_assert((Align & (Align - 1)) == 0, "Alignment must be a power of two");
+
+    private:
+        struct FreeSlot {
+            FreeSlot* next;
+        };
+        // Заголовок куска памяти, полученного у upstream
+        struct Chunk {
+            Chunk* next;
+            size_t bytes;
+        };
+
+        static constexpr size_t SLOT_ALIGN{std::max(Align, alignof(FreeSlot))};
+        static constexpr size_t SLOT_SIZE{(std::max(Size, sizeof(FreeSlot)) + SLOT_ALIGN - 1) & ~(SLOT_ALIGN - 1)};
+        static constexpr size_t CHUNK_ALIGN{std::max(SLOT_ALIGN, alignof(Chunk))};
+        static constexpr size_t HEADER_SIZE{(sizeof(Chunk) + CHUNK_ALIGN - 1) & ~(CHUNK_ALIGN - 1)};
+        static constexpr size_t MAX_CHUNK_SLOTS{64 * 1024};
+
+        FreeSlot* free_list{nullptr}; // Освобождённые слоты
+        char* bump{nullptr}; // Ещё не выданная часть последнего куска
+        char* bump_end{nullptr};
+        Chunk* chunks{nullptr};
+        size_t next_chunk_slots;
+        std::pmr::memory_resource* upstream;
+
+        // Медленный путь: новый кусок у upstream
+        void* allocate_from_new_chunk() {
+            size_t bytes = HEADER_SIZE + next_chunk_slots * SLOT_SIZE;
+            char* memory = static_cast<char*>(upstream->allocate(bytes, CHUNK_ALIGN));
+            chunks = ::new (memory) Chunk{chunks, bytes};
+            bump = memory + HEADER_SIZE + SLOT_SIZE; // Первый слот сразу выдаётся
+            bump_end = memory + bytes;
+            next_chunk_slots = std::min(next_chunk_slots * 2, MAX_CHUNK_SLOTS);
+            return memory + HEADER_SIZE;
+        }
+
+        static constexpr bool fits(size_t bytes, size_t alignment) {
+            return bytes <= Size && alignment <= Align;
+        }
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            return fits(bytes, alignment) ? allocate_node() : upstream->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+            if (fits(bytes, alignment)) {
+                deallocate_node(p);
+            } else {
+                upstream->deallocate(p, bytes, alignment);
+            }
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+    public:
+        static constexpr size_t node_size{Size};
+        static constexpr size_t node_alignment{Align};
+
+        explicit typed_node_pool(std::pmr::memory_resource* upstream_resource = std::pmr::get_default_resource(),
+                                 size_t initial_slots = 64)
+            : next_chunk_slots(std::max<size_t>(initial_slots, 1)), upstream(upstream_resource) {}
+        ~typed_node_pool() {
+            release();
+        }
+
+        typed_node_pool(const typed_node_pool&) = delete;
+        typed_node_pool& operator=(const typed_node_pool&) = delete;
+
+        void* allocate_node() {
+            if (free_list) {
+                FreeSlot* slot = free_list;
+                free_list = slot->next;
+                return slot;
+            }
+            if (bump != bump_end) {
+                void* slot = bump;
+                bump += SLOT_SIZE;
+                return slot;
+            }
+            return allocate_from_new_chunk();
+        }
+        void deallocate_node(void* p) noexcept {
+            FreeSlot* slot = static_cast<FreeSlot*>(p);
+            slot->next = free_list;
+            free_list = slot;
+        }
+
+        // Возвращает все куски upstream; выданные слоты становятся недействительными
+        void release() {
+            while (chunks) {
+                Chunk* next = chunks->next;
+                upstream->deallocate(chunks, chunks->bytes, CHUNK_ALIGN);
+                chunks = next;
+            }
+            free_list = nullptr;
+            bump = nullptr;
+            bump_end = nullptr;
+        }
+
+        std::pmr::memory_resource* upstream_resource() const {
+            return upstream;
+        }
+};
+
+// Статический аллокатор поверх typed_node_pool: выделение одного объекта,
+// помещающегося в слот, встраивается без виртуального вызова
+template <typename T, typename Pool>
+class typed_node_allocator {
+    private:
+        Pool* pool;
+        template <typename, typename>
+        friend class typed_node_allocator;
+
+        static constexpr bool fits_slot{sizeof(T) <= Pool::node_size && alignof(T) <= Pool::node_alignment};
+
+    public:
+        using value_type = T;
+
+        typed_node_allocator(Pool* node_pool) noexcept : pool(node_pool) {}
+        template <typename U>
+        typed_node_allocator(const typed_node_allocator<U, Pool>& other) noexcept : pool(other.pool) {}
+
+        T* allocate(size_t n) {
+            if constexpr (fits_slot) {
+                if (n == 1) {
+                    return static_cast<T*>(pool->allocate_node());
+                }
+            }
+            return static_cast<T*>(pool->allocate(n * sizeof(T), alignof(T)));
+        }
+        void deallocate(T* p, size_t n) noexcept {
+            if constexpr (fits_slot) {
+                if (n == 1) {
+                    pool->deallocate_node(p);
+                    return;
+                }
+            }
+            pool->deallocate(p, n * sizeof(T), alignof(T));
+        }
+
+        Pool* resource() const noexcept {
+            return pool;
+        }
+
+        template <typename U>
+        bool operator==(const typed_node_allocator<U, Pool>& other) const noexcept {
+            return pool == other.pool;
+        }
+};
@@ -0,0 +1,289 @@
+#pragma once
+#include "fixed_block_memory_resource.h"
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+#include <iterator>
+
+// Развёрнутый двусвязный список: каждый узел хранит до N элементов подряд.
+// На элемент приходится 2/N указателя вместо двух, а обход делает один
+// промах кэша на узел, а не на элемент. Интерфейс итераторов такой же,
+// как у doubly_linked_list
+template <typename T, size_t N = 16>
+class unrolled_linked_list {
+    static_assert(N > 0, "Node capacity must be positive");
+
+    private:
+        // Элементы узла занимают слоты [first, first + count): push_back
+        // растёт вправо, push_front - влево, поэтому оба края O(1)
+        struct Node {
+            Node* prev{nullptr};
+            Node* next{nullptr};
+            size_t first{0};
+            size_t count{0};
+            alignas(T) std::byte storage[N * sizeof(T)];
+
+            T* slot(size_t index) { return reinterpret_cast<T*>(storage) + index; }
+            T& element(size_t index) { return *std::launder(slot(index)); }
+            size_t end() const { return first + count; }
+        };
+
+        Node* head; // Первый узел
+        Node* tail; // Последний узел
+        size_t list_size; // Количество элементов (не узлов)
+        std::pmr::polymorphic_allocator<Node> allocator; // Аллокатор для узлов
+
+        // Выделяет пустой узел; first задаёт, с какого края он будет заполняться
+        Node* create_node(size_t first) {
+            Node* new_node = allocator.allocate(1);
+            ::new (static_cast<void*>(new_node)) Node; // Слоты не обнуляем
+            new_node->first = first;
+            return new_node;
+        }
+
+        void link_node(Node* prev, Node* new_node) {
+            Node* next = prev ? prev->next : head;
+            new_node->prev = prev;
+            new_node->next = next;
+            if (prev) {
+                prev->next = new_node;
+            } else {
+                head = new_node;
+            }
+            if (next) {
+                next->prev = new_node;
+            } else {
+                tail = new_node;
+            }
+        }
+
+        // Отвязывает опустевший узел и возвращает его память
+        void destroy_node(Node* node) {
+            if (node->prev) {
+                node->prev->next = node->next;
+            } else {
+                head = node->next;
+            }
+            if (node->next) {
+                node->next->prev = node->prev;
+            } else {
+                tail = node->prev;
+            }
+            std::destroy_at(node);
+            allocator.deallocate(node, 1);
+        }
+
+        // Конструирует элемент в слоте; при исключении освобождает
+        // узел, если он был создан только под этот элемент
+        template <typename... Args>
+        T& construct_in(Node* node, size_t index, bool fresh, Args&&... args) {
+            try {
+                std::allocator_traits<decltype(allocator)>::construct(allocator, node->slot(index), std::forward<Args>(args)...);
+            } catch (...) {
+                if (fresh) {
+                    std::destroy_at(node);
+                    allocator.deallocate(node, 1);
+                }
+                throw;
+            }
+            return node->element(index);
+        }
+
+    public:
+        // Итератор хранит узел и номер слота в нём; end() - {nullptr, 0}
+        template <bool IsConst>
+        class basic_iterator {
+            private:
+                using list_pointer = std::conditional_t<IsConst, const unrolled_linked_list*, unrolled_linked_list*>;
+
+                Node* node{nullptr};
+                size_t index{0};
+                list_pointer owner{nullptr};
+                friend class unrolled_linked_list;
+                friend class basic_iterator<!IsConst>;
+
+            public:
+                using iterator_category = std::bidirectional_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = std::conditional_t<IsConst, const T*, T*>;
+                using reference = std::conditional_t<IsConst, const T&, T&>;
+
+                basic_iterator() = default;
+                basic_iterator(Node* n, size_t i, list_pointer list) : node(n), index(i), owner(list) {}
+                // Неконстантный итератор неявно приводится к константному
+                template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+                basic_iterator(const basic_iterator<OtherConst>& other) : node(other.node), index(other.index), owner(other.owner) {}
+
+                reference operator*() const { return node->element(index); }
+                pointer operator->() const { return &node->element(index); }
+
+                basic_iterator& operator++() {
+                    if (++index == node->end()) {
+                        node = node->next;
+                        index = node ? node->first : 0;
+                    }
+                    return *this;
+                }
+
+                basic_iterator operator++(int) {
+                    basic_iterator temp = *this;
+                    ++(*this);
+                    return temp;
+                }
+
+                basic_iterator& operator--() {
+                    // Шаг назад из end() ведёт к последнему элементу
+                    if (!node) {
+                        node = owner->tail;
+                        index = node->end() - 1;
+                    } else if (index == node->first) {
+                        node = node->prev;
+                        index = node->end() - 1;
+                    } else {
+                        --index;
+                    }
+                    return *this;
+                }
+
+                basic_iterator operator--(int) {
+                    basic_iterator temp = *this;
+                    --(*this);
+                    return temp;
+                }
+
+                template <bool OtherConst>
+                bool operator==(const basic_iterator<OtherConst>& other) const {
+                    return node == other.node && index == other.index;
+                }
+
+                template <bool OtherConst>
+                bool operator!=(const basic_iterator<OtherConst>& other) const {
+                    return !(*this == other);
+                }
+        };
+
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        static constexpr size_t node_capacity = N;
+
+        unrolled_linked_list(std::pmr::memory_resource* mr) : head(nullptr),
+                                                              tail(nullptr),
+                                                              list_size(0),
+                                                              allocator(mr) {}
+        unrolled_linked_list(const unrolled_linked_list&) = delete;
+        unrolled_linked_list& operator=(const unrolled_linked_list&) = delete;
+        ~unrolled_linked_list() {
+            clear();
+        }
+
+        void push_back(const T& value) {
+            emplace_back(value);
+        };
+        void push_back(T&& value) {
+            emplace_back(std::move(value));
+        };
+        void push_front(const T& value) {
+            emplace_front(value);
+        };
+        void push_front(T&& value) {
+            emplace_front(std::move(value));
+        };
+
+        template <typename... Args>
+        T& emplace_back(Args&&... args) {
+            Node* node = tail;
+            bool fresh = !node || node->end() == N;
+            if (fresh) {
+                node = create_node(0);
+            }
+            T& value = construct_in(node, node->end(), fresh, std::forward<Args>(args)...);
+            if (fresh) {
+                link_node(tail, node);
+            }
+            ++node->count;
+            ++list_size;
+            return value;
+        };
+        template <typename... Args>
+        T& emplace_front(Args&&... args) {
+            Node* node = head;
+            bool fresh = !node || node->first == 0;
+            if (fresh) {
+                node = create_node(N);
+            }
+            T& value = construct_in(node, node->first - 1, fresh, std::forward<Args>(args)...);
+            if (fresh) {
+                link_node(nullptr, node);
+            }
+            --node->first;
+            ++node->count;
+            ++list_size;
+            return value;
+        };
+
+        void pop_back() {
+            if (!tail) {
+                throw std::out_of_range("List is empty");
+            }
+            std::destroy_at(&tail->element(tail->end() - 1));
+            --list_size;
+            if (--tail->count == 0) {
+                destroy_node(tail);
+            }
+        };
+        void pop_front() {
+            if (!head) {
+                throw std::out_of_range("List is empty");
+            }
+            std::destroy_at(&head->element(head->first));
+            ++head->first;
+            --list_size;
+            if (--head->count == 0) {
+                destroy_node(head);
+            }
+        };
+
+        size_t size() const {
+            return list_size;
+        };
+        bool empty() const {
+            return list_size == 0;
+        };
+        void clear() {
+            while (head) {
+                for (size_t i = head->first; i < head->end(); ++i) {
+                    std::destroy_at(&head->element(i));
+                }
+                head->count = 0;
+                destroy_node(head);
+            }
+            list_size = 0;
+        };
+        void print_list() const {
+            for (const T& value : *this) {
+                std::cout << value << " ";
+            }
+            std::cout << std::endl;
+        };
+
+        iterator begin() { return iterator(head, head ? head->first : 0, this); }
+        iterator end() { return iterator(nullptr, 0, this); }
+        const_iterator begin() const { return const_iterator(head, head ? head->first : 0, this); }
+        const_iterator end() const { return const_iterator(nullptr, 0, this); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crbegin() const { return rbegin(); }
+        const_reverse_iterator crend() const { return rend(); }
+};
@@ -1,59 +1,874 @@
 #include "../include/fixed_block_memory_resource.h"
 #include <cassert>
+#include <cstdint>
 #include <stdexcept>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <system_error>
+#include <sstream>
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
+// Инструментирование горячего пути отключается при сборке без FIXED_BLOCK_STATS
+#if defined(FIXED_BLOCK_STATS)
+#define FIXED_BLOCK_STAT(statement) statement
+#else
+#define FIXED_BLOCK_STAT(statement)
+#endif
 
-fixed_block_memory_resource::fixed_block_memory_resource(size_t size) : pool_size(size), block_size(0) {
-    memory_pool = new char[pool_size];  // Выделяем большой блок
+namespace {
+    uintptr_t align_up(uintptr_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+namespace {
+    constexpr std::uint64_t FILE_MAGIC{0x4C4142354642504FULL}; // "OPBF5BAL"
+    constexpr std::uint32_t FILE_VERSION{2};
+
+#if defined(__linux__)
+    constexpr size_t HUGE_PAGE_SIZE{2 * 1024 * 1024};
+    constexpr int MPOL_BIND_POLICY{2}; // MPOL_BIND из <numaif.h>
+
+    char* map_pool(size_t size, const fixed_block_memory_resource::options& opts) {
+        using huge_pages = fixed_block_memory_resource::huge_pages;
+
+        // MAP_NORESERVE: страницы не резервируются заранее, запуск большого пула мгновенный
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+        if (opts.pages == huge_pages::required) {
+            flags |= MAP_HUGETLB;
+        }
+        void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (base == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "mmap of memory pool failed");
+        }
+        if (opts.pages == huge_pages::advise) {
+            // Подсказка ядру; если прозрачные большие страницы выключены, она игнорируется
+            ::madvise(base, size, MADV_HUGEPAGE);
+        }
+        if (opts.numa_node >= 0) {
+            // Политика применяется к страницам при первом обращении к ним
+            constexpr size_t MASK_BITS = sizeof(unsigned long) * 8;
+            if (static_cast<size_t>(opts.numa_node) >= MASK_BITS) {
+                ::munmap(base, size);
+                throw std::invalid_argument("NUMA node is out of range");
+            }
+            unsigned long node_mask = 1UL << opts.numa_node;
+            if (::syscall(SYS_mbind, base, size, MPOL_BIND_POLICY, &node_mask, MASK_BITS, 0) != 0) {
+                int error = errno;
+                ::munmap(base, size);
+                throw std::system_error(error, std::generic_category(), "mbind of memory pool failed");
+            }
+        }
+        return static_cast<char*>(base);
+    }
+#endif
+}
+
+fixed_block_memory_resource::PoolStorage::PoolStorage(size_t pool_bytes, const options& opts) : size(pool_bytes) {
+    if (opts.backing == backing_store::heap) {
+        if (opts.pages != huge_pages::none || opts.numa_node >= 0) {
+            throw std::invalid_argument("Huge pages and NUMA placement require backing_store::mmap");
+        }
+        base = new char[size];  // Выделяем большой блок
+        return;
+    }
+#if defined(__linux__)
+    if (opts.backing == backing_store::file) {
+        map_file(opts);
+        return;
+    }
+    // Отображение с MAP_HUGETLB должно быть кратно размеру большой страницы
+    mapped_size = opts.pages == huge_pages::required ? align_up(size, HUGE_PAGE_SIZE) : size;
+    base = map_pool(mapped_size, opts);
+#else
+    throw std::invalid_argument("backing_store::mmap and backing_store::file are not supported on this platform");
+#endif
+}
+
+#if defined(__linux__)
+void fixed_block_memory_resource::PoolStorage::map_file(const options& opts) {
+    if (opts.file_path.empty()) {
+        throw std::invalid_argument("backing_store::file requires options.file_path");
+    }
+    // Дополнительные арены живут вне файла и не переживут перезапуск
+    if (opts.growable) {
+        throw std::invalid_argument("backing_store::file requires a non-growable pool");
+    }
+    if (opts.pages != huge_pages::none || opts.numa_node >= 0) {
+        throw std::invalid_argument("Huge pages and NUMA placement are not supported for backing_store::file");
+    }
+
+    fd = ::open(opts.file_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "open of pool file failed");
+    }
+    auto fail = [this](int error, const char* message) {
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), message);
+    };
+    struct stat file_stat;
+    if (::fstat(fd, &file_stat) != 0) {
+        fail(errno, "fstat of pool file failed");
+    }
+    bool created = file_stat.st_size == 0;
+    mapped_size = created ? FILE_HEADER_SIZE + (size & ~(GRANULE - 1)) : static_cast<size_t>(file_stat.st_size);
+    if (mapped_size <= FILE_HEADER_SIZE) {
+        ::close(fd);
+        throw std::invalid_argument("Pool file is too small");
+    }
+    if (created && ::ftruncate(fd, static_cast<off_t>(mapped_size)) != 0) {
+        fail(errno, "ftruncate of pool file failed");
+    }
+    void* mapping = ::mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        fail(errno, "mmap of pool file failed");
+    }
+
+    header = static_cast<FileHeader*>(mapping);
+    if (created) {
+        *header = FileHeader{FILE_MAGIC, mapped_size - FILE_HEADER_SIZE, 0, 0, FILE_VERSION, 1, {}};
+        header->bins.heads.fill(NO_CHUNK);
+    } else if (header->magic != FILE_MAGIC || header->version != FILE_VERSION ||
+               header->pool_size != mapped_size - FILE_HEADER_SIZE ||
+               header->pool_size < MIN_CHUNK + sizeof(ChunkHeader) ||
+               header->used > header->pool_size - sizeof(ChunkHeader)) {
+        ::munmap(mapping, mapped_size);
+        ::close(fd);
+        throw std::invalid_argument("File is not a memory pool");
+    }
+    // Флаг снова станет 1 только в деструкторе
+    opened_cleanly = header->clean != 0;
+    header->clean = 0;
+    base = static_cast<char*>(mapping) + FILE_HEADER_SIZE;
+    size = header->pool_size;
+}
+#endif
+
+fixed_block_memory_resource::PoolStorage::~PoolStorage() {
+#if defined(__linux__)
+    if (header) {
+        header->clean = 1;
+        ::msync(header, mapped_size, MS_SYNC);
+        ::munmap(header, mapped_size);
+        ::close(fd);
+        return;
+    }
+    if (mapped_size != 0) {
+        ::munmap(base, mapped_size);
+        return;
+    }
+#endif
+    delete[] base;
+}
+
+fixed_block_memory_resource::fixed_block_memory_resource(size_t size)
+    : fixed_block_memory_resource(size, options{}) {}
+
+fixed_block_memory_resource::fixed_block_memory_resource(size_t size, const options& opts)
+    : pool_storage(size, opts),
+      memory_pool(pool_storage.base),
+      pool_size(pool_storage.size & ~(GRANULE - 1)),
+      settings(opts),
+      metadata_pool(std::pmr::new_delete_resource()),
+      blocks(&metadata_pool),
+      block_index(&metadata_pool),
+      chunk_bins(&own_chunk_bins),
+      block_size(0) {
+    assert(reinterpret_cast<uintptr_t>(memory_pool) % GRANULE == 0 && "Pool must be granule-aligned");
+    if (opts.growable && opts.growth_factor < 1.0) {
+        throw std::invalid_argument("Growth factor must be at least 1");
+    }
+    if (in_block() && pool_size < MIN_CHUNK + sizeof(ChunkHeader)) {
+        throw std::invalid_argument("Pool is too small for in_pool metadata");
+    }
+    arena_chain.upstream = opts.upstream ? opts.upstream : std::pmr::new_delete_resource();
+    arena_chain.arenas.push_back({memory_pool, pool_size, 0});
+    reset_bins();
+    if (pool_storage.header) {
+        // Заголовки участков лежат в файле, а корзины и "хвост" - в заголовке
+        // файла: открытие пула заново ничего не обходит
+        chunk_bins = &pool_storage.header->bins;
+        arena_chain.arenas.front().used = pool_storage.header->used;
+        // Живые блоки прошлых сеансов - всё, что до "хвоста" и не в корзинах
+        FIXED_BLOCK_STAT(stats.live_bytes = stats.peak_live_bytes = pool_storage.header->used - chunk_bins->free_bytes);
+    }
 }
 
 fixed_block_memory_resource::~fixed_block_memory_resource() {
-    delete[] memory_pool;  // Освобождаем пул
-    // std::list освободится сам
+    // Метаданные освобождаются раньше пула, в котором они могут храниться
 }
 
-void* fixed_block_memory_resource::do_allocate(size_t bytes, size_t alignment) {
-    // Поиск свободного места в пуле
-    for (auto it = blocks.begin(); it != blocks.end(); ++it) {
-        if (it->is_free && it->size >= bytes) {
-            // Проверяем выровнивание
-            uintptr_t addr = reinterpret_cast<uintptr_t>(it->ptr);
-            if (addr % alignment == 0) {
-                it->is_free = false;
-                return it->ptr;
+fixed_block_memory_resource::ArenaChain::~ArenaChain() {
+    // Первая арена принадлежит pool_storage
+    for (size_t i = 1; i < arenas.size(); ++i) {
+        upstream->deallocate(arenas[i].base, arenas[i].size, alignof(std::max_align_t));
+    }
+}
+
+bool fixed_block_memory_resource::adjacent(const MemoryBlock& first, const MemoryBlock& second) const {
+    if (static_cast<char*>(first.ptr) + first.size != second.ptr) {
+        return false;
+    }
+    // Upstream может выдать арены подряд, но блоки разных арен не сливаются:
+    // иначе после разделения блок мог бы пересечь границу арен
+    for (size_t i = 1; i < arena_chain.arenas.size(); ++i) {
+        if (arena_chain.arenas[i].base == second.ptr) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void fixed_block_memory_resource::add_arena(size_t min_size) {
+    // Место под новую арену резервируется заранее: после выделения у upstream
+    // добавление в цепочку уже не бросает
+    arena_chain.arenas.reserve(arena_chain.arenas.size() + 1);
+    Arena& last = arena_chain.arenas.back();
+    size_t total = 0;
+    for (const auto& arena : arena_chain.arenas) {
+        total += arena.size;
+    }
+    size_t size = std::max(static_cast<size_t>(static_cast<double>(last.size) * settings.growth_factor),
+                           static_cast<size_t>(align_up(min_size, GRANULE)));
+    if (settings.max_total_size != 0) {
+        if (total >= settings.max_total_size || settings.max_total_size - total < min_size) {
+            throw std::bad_alloc(); // Достигнут предел роста
+        }
+        size = std::min(size, settings.max_total_size - total);
+    }
+    char* base = static_cast<char*>(arena_chain.upstream->allocate(size, GRANULE));
+    assert(reinterpret_cast<uintptr_t>(base) % GRANULE == 0 && "Arena must be granule-aligned");
+
+    if (in_block()) {
+        // Остаток "хвоста" становится свободным участком, а за последним
+        // участком арены ставится барьер с нулевым размером: через него
+        // участки не сливаются с соседней ареной
+        size_t limit = chunk_limit(last);
+        auto* fence = reinterpret_cast<ChunkHeader*>(last.base + last.used);
+        if (limit - last.used >= MIN_CHUNK) {
+            auto* rest = fence;
+            fence = reinterpret_cast<ChunkHeader*>(last.base + limit);
+            fence->size = 0;
+            rest->size = PREV_IN_USE; // Последний участок арены всегда занят
+            link_chunk(rest, limit - last.used);
+        } else {
+            fence->size = PREV_IN_USE;
+        }
+        last.used = last.size;
+        arena_chain.arenas.push_back({base, size, 0});
+        return;
+    }
+
+    // Остаток "хвоста" текущей арены становится свободным блоком
+    size_t rest = (last.size - last.used) & ~(GRANULE - 1);
+    if (rest > 0) {
+        char* rest_ptr = last.base + last.used;
+        // При last.used == 0 блок, оканчивающийся на rest_ptr, лежит в предыдущей арене
+        if (last.used > 0 && !blocks.empty() && blocks.back().is_free &&
+            static_cast<char*>(blocks.back().ptr) + blocks.back().size == rest_ptr) {
+            block_iterator tail_block = std::prev(blocks.end());
+            unlink_free(tail_block);
+            tail_block->size += rest;
+            link_free(tail_block);
+        } else {
+            try {
+                link_free(append_block(rest_ptr, rest));
+            } catch (...) {
+                // Нет места под метаданные: арена возвращается upstream
+                arena_chain.upstream->deallocate(base, size, GRANULE);
+                throw;
             }
         }
     }
-    // Если свободного блока нет, выделяем из "хвоста" пула
-    uintptr_t current_addr = reinterpret_cast<uintptr_t>(memory_pool + used_bytes);
-    uintptr_t aligned_addr = (current_addr + alignment - 1) & ~(alignment - 1);
+    last.used = last.size;
+
+    arena_chain.arenas.push_back({base, size, 0});
+}
+
+size_t fixed_block_memory_resource::bin_for(size_t size) {
+    if (size / GRANULE <= SMALL_BINS) {
+        return size / GRANULE - 1;
+    }
+    // Крупные блоки: по корзине на диапазон [2^k, 2^(k+1))
+    return SMALL_BINS + static_cast<size_t>(std::bit_width(size) - std::bit_width(SMALL_BINS * GRANULE));
+}
+
+void fixed_block_memory_resource::reset_bins() {
+    free_bins.fill({blocks.end(), blocks.end()});
+    bin_mask.fill(0);
+    free_block_bytes = 0;
+    chunk_bins->heads.fill(NO_CHUNK);
+    chunk_bins->mask.fill(0);
+    chunk_bins->free_bytes = 0;
+}
+
+void fixed_block_memory_resource::link_free(block_iterator it) noexcept {
+    size_t index = bin_for(it->size);
+    free_bin& bin = free_bins[index];
+    it->is_free = true;
+    it->prev_free = bin.last;
+    it->next_free = blocks.end();
+    if (bin.last != blocks.end()) {
+        bin.last->next_free = it;
+    } else {
+        bin.first = it;
+        bin_mask[index / 64] |= std::uint64_t{1} << (index % 64);
+    }
+    bin.last = it;
+    free_block_bytes += it->size;
+}
+
+void fixed_block_memory_resource::unlink_free(block_iterator it) noexcept {
+    size_t index = bin_for(it->size);
+    free_bin& bin = free_bins[index];
+    if (it->prev_free != blocks.end()) {
+        it->prev_free->next_free = it->next_free;
+    } else {
+        bin.first = it->next_free;
+    }
+    if (it->next_free != blocks.end()) {
+        it->next_free->prev_free = it->prev_free;
+    } else {
+        bin.last = it->prev_free;
+    }
+    if (bin.first == blocks.end()) {
+        bin_mask[index / 64] &= ~(std::uint64_t{1} << (index % 64));
+    }
+    it->is_free = false;
+    free_block_bytes -= it->size;
+}
+
+size_t fixed_block_memory_resource::next_bin(const std::array<std::uint64_t, BIN_COUNT / 64>& mask, size_t bin) {
+    for (size_t word = bin / 64; word < mask.size(); ++word) {
+        std::uint64_t bits = mask[word];
+        if (word == bin / 64) {
+            bits &= ~std::uint64_t{0} << (bin % 64);
+        }
+        if (bits != 0) {
+            return word * 64 + static_cast<size_t>(std::countr_zero(bits));
+        }
+    }
+    return BIN_COUNT;
+}
+
+void fixed_block_memory_resource::split_block(block_iterator it, size_t size) {
+    // Остаток всегда кратен грануле, поэтому его можно выделить в отдельный блок
+    void* rest_ptr = static_cast<char*>(it->ptr) + size;
+    block_iterator rest = blocks.insert(std::next(it), {rest_ptr, it->size - size, true});
+    try {
+        block_index.emplace(rest_ptr, rest);
+    } catch (...) {
+        blocks.erase(rest);
+        throw;
+    }
+    it->size = size;
+    link_free(rest);
+}
+
+fixed_block_memory_resource::block_iterator fixed_block_memory_resource::append_block(void* ptr, size_t size) {
+    blocks.push_back({ptr, size, false});
+    try {
+        block_index.emplace(ptr, std::prev(blocks.end()));
+    } catch (...) {
+        blocks.pop_back();
+        throw;
+    }
+    return std::prev(blocks.end());
+}
+
+void* fixed_block_memory_resource::allocate_from_tail(size_t size, size_t alignment) {
+    Arena& arena = arena_chain.arenas.back();
+    char* tail = arena.base + arena.used;
+
+    // Свободный последний блок примыкает к "хвосту" и расширяется за его счёт
+    block_iterator last_free = blocks.end();
+    uintptr_t current_addr = reinterpret_cast<uintptr_t>(tail);
+    if (arena.used > 0 && !blocks.empty() && blocks.back().is_free &&
+        static_cast<char*>(blocks.back().ptr) + blocks.back().size == tail) {
+        last_free = std::prev(blocks.end());
+        current_addr = reinterpret_cast<uintptr_t>(last_free->ptr);
+    }
+    uintptr_t aligned_addr = align_up(current_addr, alignment);
     size_t padding = aligned_addr - current_addr; // Вычисляем отступ для выравнивания
-    
-    // Проверяем, хватает ли места в пуле
-    if (used_bytes + padding + bytes > pool_size) {
-        throw std::bad_alloc(); // Недостаточно памяти
+    size_t end_offset = aligned_addr + size - reinterpret_cast<uintptr_t>(arena.base);
+
+    // Проверяем, хватает ли места в арене
+    if (end_offset > arena.size) {
+        if (!settings.growable) {
+            throw std::bad_alloc(); // Недостаточно памяти
+        }
+        // Новая арена с запасом на выравнивание
+        add_arena(size + (alignment > GRANULE ? alignment : 0));
+        return allocate_from_tail(size, alignment);
     }
 
-    // Выделяем память
     void* ptr = reinterpret_cast<void*>(aligned_addr);
-    blocks.push_back({ptr, bytes, false});
-    used_bytes += padding + bytes;
+    // Метаданные новых блоков создаются до изменения существующих,
+    // поэтому при их нехватке пул остаётся прежним
+    if (last_free != blocks.end()) {
+        if (padding > 0) {
+            append_block(ptr, size);
+        }
+        unlink_free(last_free);
+        if (padding == 0) {
+            last_free->size = size;
+            arena.used = end_offset;
+            store_tail();
+            return ptr;
+        }
+        // Отступ остаётся свободным блоком
+        last_free->size = padding;
+        link_free(last_free);
+    } else {
+        // Отступ кратен грануле и становится свободным блоком
+        block_iterator padding_block = blocks.end();
+        if (padding > 0) {
+            padding_block = append_block(reinterpret_cast<void*>(current_addr), padding);
+        }
+        try {
+            append_block(ptr, size);
+        } catch (...) {
+            if (padding_block != blocks.end()) {
+                block_index.erase(padding_block->ptr);
+                blocks.erase(padding_block);
+            }
+            throw;
+        }
+        if (padding_block != blocks.end()) {
+            link_free(padding_block);
+        }
+    }
+
+    // Выделяем память
+    arena.used = end_offset;
+    store_tail();
 
     return ptr;
 }
 
-void fixed_block_memory_resource::do_deallocate(void* p, size_t bytes, size_t alignment) {
-    // Находим блок и помечаем его как свободный
-    for (auto it = blocks.begin(); it != blocks.end(); ++it) {
-        if (it->ptr == p) {
-            assert(it->size == bytes && "Deallocating block with incorrect size");
-            it->is_free = true;
-            return;
+fixed_block_memory_resource::ChunkHeader* fixed_block_memory_resource::chunk_at(std::uint64_t offset) const {
+    return reinterpret_cast<ChunkHeader*>(reinterpret_cast<uintptr_t>(memory_pool) + offset);
+}
+
+std::uint64_t fixed_block_memory_resource::chunk_offset(const ChunkHeader* chunk) const {
+    // Арены upstream лежат вне memory_pool: смещение считается по модулю 2^64
+    return reinterpret_cast<uintptr_t>(chunk) - reinterpret_cast<uintptr_t>(memory_pool);
+}
+
+fixed_block_memory_resource::ChunkHeader* fixed_block_memory_resource::chunk_after(ChunkHeader* chunk, size_t size) {
+    return reinterpret_cast<ChunkHeader*>(reinterpret_cast<char*>(chunk) + size);
+}
+
+void fixed_block_memory_resource::link_chunk(ChunkHeader* chunk, size_t size) noexcept {
+    chunk->size = size | (chunk->size & PREV_IN_USE);
+    ChunkHeader* next = chunk_after(chunk, size);
+    next->prev_size = size;
+    next->size &= ~PREV_IN_USE;
+
+    size_t index = bin_for(size);
+    auto* free_chunk = reinterpret_cast<FreeChunk*>(chunk);
+    std::uint64_t offset = chunk_offset(chunk);
+    free_chunk->prev = NO_CHUNK;
+    free_chunk->next = chunk_bins->heads[index];
+    if (free_chunk->next != NO_CHUNK) {
+        reinterpret_cast<FreeChunk*>(chunk_at(free_chunk->next))->prev = offset;
+    } else {
+        chunk_bins->mask[index / 64] |= std::uint64_t{1} << (index % 64);
+    }
+    chunk_bins->heads[index] = offset;
+    chunk_bins->free_bytes += size;
+}
+
+void fixed_block_memory_resource::unlink_chunk(ChunkHeader* chunk) noexcept {
+    size_t size = chunk->size & ~PREV_IN_USE;
+    size_t index = bin_for(size);
+    auto* free_chunk = reinterpret_cast<FreeChunk*>(chunk);
+    if (free_chunk->prev != NO_CHUNK) {
+        reinterpret_cast<FreeChunk*>(chunk_at(free_chunk->prev))->next = free_chunk->next;
+    } else {
+        chunk_bins->heads[index] = free_chunk->next;
+        if (free_chunk->next == NO_CHUNK) {
+            chunk_bins->mask[index / 64] &= ~(std::uint64_t{1} << (index % 64));
+        }
+    }
+    if (free_chunk->next != NO_CHUNK) {
+        reinterpret_cast<FreeChunk*>(chunk_at(free_chunk->next))->prev = free_chunk->prev;
+    }
+    chunk_bins->free_bytes -= size;
+}
+
+void* fixed_block_memory_resource::take_chunk(ChunkHeader* chunk, size_t size) noexcept {
+    size_t whole = chunk->size & ~PREV_IN_USE;
+    if (whole - size >= MIN_CHUNK) {
+        // Остаток свободен, поэтому флаг следующего за ним участка не меняется
+        ChunkHeader* rest = chunk_after(chunk, size);
+        rest->size = PREV_IN_USE;
+        link_chunk(rest, whole - size);
+        chunk->size = size | (chunk->size & PREV_IN_USE);
+    } else {
+        chunk_after(chunk, whole)->size |= PREV_IN_USE;
+    }
+    return reinterpret_cast<char*>(chunk) + sizeof(ChunkHeader);
+}
+
+void* fixed_block_memory_resource::allocate_chunk(size_t bytes, size_t alignment) {
+    size_t size = chunk_size(bytes);
+    [[maybe_unused]] size_t searched = 0;
+
+    // Поиск по корзинам тот же, что и в режиме heap
+    size_t target = bin_for(size);
+    for (size_t bin = next_bin(chunk_bins->mask, target); bin < BIN_COUNT; bin = next_bin(chunk_bins->mask, bin + 1)) {
+        ChunkHeader* found = nullptr;
+        size_t found_size = 0;
+        size_t lead = 0;
+        for (std::uint64_t offset = chunk_bins->heads[bin]; offset != NO_CHUNK;
+             offset = reinterpret_cast<FreeChunk*>(chunk_at(offset))->next) {
+            FIXED_BLOCK_STAT(++searched);
+            ChunkHeader* candidate = chunk_at(offset);
+            size_t candidate_size = candidate->size & ~PREV_IN_USE;
+            // Отступ до выровненных данных должен вместить свободный участок
+            uintptr_t data = reinterpret_cast<uintptr_t>(candidate) + sizeof(ChunkHeader);
+            size_t candidate_lead = align_up(data, alignment) - data;
+            if (candidate_lead > 0 && candidate_lead < MIN_CHUNK) {
+                candidate_lead += alignment;
+            }
+            if (candidate_lead + size > candidate_size) {
+                continue;
+            }
+            if (!found || candidate_size < found_size) {
+                found = candidate;
+                found_size = candidate_size;
+                lead = candidate_lead;
+            }
+            if (bin < SMALL_BINS || bin != target) {
+                break;
+            }
+        }
+        if (!found) {
+            continue;
+        }
+
+        unlink_chunk(found);
+        if (lead > 0) {
+            // Отступ перед выровненным участком остаётся свободным
+            ChunkHeader* aligned = chunk_after(found, lead);
+            aligned->size = found_size - lead;
+            link_chunk(found, lead);
+            found = aligned;
         }
+        void* ptr = take_chunk(found, size);
+        FIXED_BLOCK_STAT(record_allocation(bytes, size, searched, true));
+        return ptr;
     }
+    void* ptr = allocate_chunk_from_tail(size, alignment);
+    FIXED_BLOCK_STAT(record_allocation(bytes, size, searched, false));
+    return ptr;
+}
+
+void* fixed_block_memory_resource::allocate_chunk_from_tail(size_t size, size_t alignment) {
+    Arena& arena = arena_chain.arenas.back();
+    auto* tail = reinterpret_cast<ChunkHeader*>(arena.base + arena.used);
+    uintptr_t data = reinterpret_cast<uintptr_t>(tail) + sizeof(ChunkHeader);
+    size_t lead = align_up(data, alignment) - data;
+    if (lead > 0 && lead < MIN_CHUNK) {
+        lead += alignment;
+    }
+
+    if (chunk_limit(arena) - arena.used < lead + size) {
+        if (!settings.growable) {
+            throw std::bad_alloc(); // Недостаточно памяти
+        }
+        add_arena(size + lead + alignment + sizeof(ChunkHeader));
+        return allocate_chunk_from_tail(size, alignment);
+    }
+
+    // Участок перед "хвостом" всегда занят: свободный сливается с "хвостом"
+    ChunkHeader* chunk = chunk_after(tail, lead);
+    chunk->size = size | PREV_IN_USE;
+    if (lead > 0) {
+        tail->size = PREV_IN_USE;
+        link_chunk(tail, lead);
+    }
+    arena.used += lead + size;
+    store_tail();
+    return reinterpret_cast<char*>(chunk) + sizeof(ChunkHeader);
+}
+
+fixed_block_memory_resource::Arena* fixed_block_memory_resource::arena_of(const void* p) {
+    auto addr = reinterpret_cast<uintptr_t>(p);
+    for (auto& arena : arena_chain.arenas) {
+        auto base = reinterpret_cast<uintptr_t>(arena.base);
+        if (addr >= base && addr < base + arena.size) {
+            return &arena;
+        }
+    }
+    return nullptr;
+}
+
+void fixed_block_memory_resource::release_chunk(void* p, size_t bytes) {
+    Arena* arena = arena_of(p);
+    char* ptr = static_cast<char*>(p);
+    if (!arena || reinterpret_cast<uintptr_t>(ptr) % GRANULE != 0 ||
+        static_cast<size_t>(ptr - arena->base) < sizeof(ChunkHeader)) {
+        throw std::invalid_argument("Pointer not allocated by this memory resource");
+    }
+    auto* chunk = reinterpret_cast<ChunkHeader*>(ptr - sizeof(ChunkHeader));
+    size_t size = chunk->size & ~PREV_IN_USE;
+    size_t expected = chunk_size(bytes);
+    char* used_end = arena->base + arena->used;
+    // Остаток меньше MIN_CHUNK при выделении не отрезается. Участок,
+    // слитый с "хвостом", лежит за used_end
+    if (size < expected || size - expected >= MIN_CHUNK || reinterpret_cast<char*>(chunk) >= used_end ||
+        size > static_cast<size_t>(used_end - reinterpret_cast<char*>(chunk))) {
+        throw std::invalid_argument("Pointer not allocated by this memory resource");
+    }
+    // Занятость участка записана в PREV_IN_USE следующего; последний
+    // участок перед "хвостом" занят всегда
+    bool last_arena = arena == &arena_chain.arenas.back();
+    ChunkHeader* next = chunk_after(chunk, size);
+    bool at_tail = last_arena && reinterpret_cast<char*>(next) == used_end;
+    if (!at_tail && !(next->size & PREV_IN_USE)) {
+        throw std::invalid_argument("Block already deallocated");
+    }
+    FIXED_BLOCK_STAT(++stats.deallocations);
+    FIXED_BLOCK_STAT(stats.live_bytes -= size);
+    // Потери блоков прошлых сеансов файла в счётчике не учтены
+    FIXED_BLOCK_STAT(stats.padding_bytes -= std::min(stats.padding_bytes, size - std::max<size_t>(bytes, 1)));
+
+    // Сливаем участок со свободными соседями
+    if (!(chunk->size & PREV_IN_USE)) {
+        auto* prev = reinterpret_cast<ChunkHeader*>(reinterpret_cast<char*>(chunk) - chunk->prev_size);
+        unlink_chunk(prev);
+        size += chunk->prev_size;
+        chunk = prev;
+    }
+    if (at_tail) {
+        arena->used = static_cast<size_t>(reinterpret_cast<char*>(chunk) - arena->base);
+        store_tail();
+        return;
+    }
+    size_t next_size = next->size & ~PREV_IN_USE;
+    if (next_size != 0) { // Не барьер в конце арены
+        ChunkHeader* after = chunk_after(next, next_size);
+        bool next_last = last_arena && reinterpret_cast<char*>(after) == used_end;
+        if (!next_last && !(after->size & PREV_IN_USE)) {
+            unlink_chunk(next);
+            // Заголовок next остаётся внутри слитого участка: без флага
+            // повторное освобождение блока не примет его за занятый
+            next->size &= ~PREV_IN_USE;
+            size += next_size;
+        }
+    }
+    link_chunk(chunk, size);
+}
+
+void fixed_block_memory_resource::record_allocation(size_t bytes, size_t size, size_t searched, bool reused) {
+    ++stats.allocations;
+    if (reused) {
+        ++stats.reused_allocations;
+    }
+    stats.live_bytes += size;
+    stats.peak_live_bytes = std::max(stats.peak_live_bytes, stats.live_bytes);
+    stats.padding_bytes += size - std::max<size_t>(bytes, 1);
+
+    // Корзина гистограммы: 0, 1, 2-3, 4-7, ...
+    size_t bucket = 0;
+    while (searched > 0 && bucket + 1 < statistics::HISTOGRAM_BUCKETS) {
+        searched >>= 1;
+        ++bucket;
+    }
+    ++stats.search_length_histogram[bucket];
+}
+
+void* fixed_block_memory_resource::do_allocate(size_t bytes, size_t alignment) {
+    if (in_block()) {
+        try {
+            return allocate_chunk(bytes, alignment);
+        } catch (const std::bad_alloc&) {
+            FIXED_BLOCK_STAT(++stats.failed_allocations);
+            throw;
+        }
+    }
+    size_t size = align_up(bytes == 0 ? 1 : bytes, GRANULE);
+    [[maybe_unused]] size_t searched = 0;
+
+    // Best-fit: начиная с корзины запроса. В точных корзинах и в корзинах
+    // крупнее запроса подходит первый же блок, а в диапазонной корзине самого
+    // запроса ищется наименьший подходящий
+    size_t target = bin_for(size);
+    for (size_t bin = next_bin(bin_mask, target); bin < BIN_COUNT; bin = next_bin(bin_mask, bin + 1)) {
+        block_iterator it = blocks.end();
+        size_t padding = 0;
+        for (block_iterator candidate = free_bins[bin].last; candidate != blocks.end(); candidate = candidate->prev_free) {
+            FIXED_BLOCK_STAT(++searched);
+            uintptr_t block_addr = reinterpret_cast<uintptr_t>(candidate->ptr);
+            size_t candidate_padding = align_up(block_addr, alignment) - block_addr;
+            // Для выравнивания не больше гранулы подходит первый же блок
+            if (candidate_padding + size > candidate->size) {
+                continue;
+            }
+            if (it == blocks.end() || candidate->size < it->size) {
+                it = candidate;
+                padding = candidate_padding;
+            }
+            if (bin < SMALL_BINS || bin != target) {
+                break;
+            }
+        }
+        if (it == blocks.end()) {
+            continue;
+        }
+
+        unlink_free(it);
+        try {
+            if (padding > 0) {
+                // Отступ перед выровненным адресом остаётся свободным
+                split_block(it, padding);
+                link_free(it);
+                it = std::next(it);
+                unlink_free(it);
+            }
+            if (it->size > size) {
+                split_block(it, size);
+            }
+        } catch (...) {
+            // Не хватило памяти под метаданные: блок возвращается в корзины
+            release_block(it);
+            FIXED_BLOCK_STAT(++stats.failed_allocations);
+            throw;
+        }
+        FIXED_BLOCK_STAT(record_allocation(bytes, size, searched, true));
+        return it->ptr;
+    }
+    // Если подходящего свободного блока нет, выделяем из "хвоста" пула
+    try {
+        void* ptr = allocate_from_tail(size, alignment);
+        FIXED_BLOCK_STAT(record_allocation(bytes, size, searched, false));
+        return ptr;
+    } catch (const std::bad_alloc&) {
+        FIXED_BLOCK_STAT(++stats.failed_allocations);
+        throw;
+    }
+}
+
+void fixed_block_memory_resource::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    if (in_block()) {
+        release_chunk(p, bytes);
+        return;
+    }
+    // Находим блок по адресу и помечаем его как свободный
+    auto index_it = block_index.find(p);
     // Если блок не найден, это ошибка
-    throw std::invalid_argument("Pointer not allocated by this memory resource");
+    if (index_it == block_index.end()) {
+        throw std::invalid_argument("Pointer not allocated by this memory resource");
+    }
+
+    block_iterator it = index_it->second;
+    assert(it->size == align_up(bytes == 0 ? 1 : bytes, GRANULE) && "Deallocating block with incorrect size");
+    if (it->is_free) {
+        throw std::invalid_argument("Block already deallocated");
+    }
+    FIXED_BLOCK_STAT(++stats.deallocations);
+    FIXED_BLOCK_STAT(stats.live_bytes -= it->size);
+    FIXED_BLOCK_STAT(stats.padding_bytes -= it->size - std::max<size_t>(bytes, 1));
+
+    release_block(it);
+}
+
+void fixed_block_memory_resource::release_block(block_iterator it) {
+    // Сливаем блок со свободными физическими соседями из той же арены
+    if (it != blocks.begin() && std::prev(it)->is_free && adjacent(*std::prev(it), *it)) {
+        block_iterator prev = std::prev(it);
+        unlink_free(prev);
+        prev->size += it->size;
+        block_index.erase(it->ptr);
+        blocks.erase(it);
+        it = prev;
+    }
+    if (std::next(it) != blocks.end() && std::next(it)->is_free && adjacent(*it, *std::next(it))) {
+        block_iterator next = std::next(it);
+        unlink_free(next);
+        it->size += next->size;
+        block_index.erase(next->ptr);
+        blocks.erase(next);
+    }
+    // Возвращаем блок в корзину его размера
+    link_free(it);
+}
+
+void* fixed_block_memory_resource::allocate_contiguous(size_t bytes, size_t alignment, size_t count) {
+    if (alignment > GRANULE) {
+        // При шаге, кратном лишь грануле, выровнять можно только первый блок
+        throw std::invalid_argument("allocate_contiguous supports alignment up to alignof(max_align_t)");
+    }
+    if (count == 0) {
+        return nullptr;
+    }
+    size_t size = block_stride(bytes);
+    if (count > SIZE_MAX / size) {
+        throw std::bad_alloc();
+    }
+
+    if (in_block()) {
+        char* base;
+        try {
+            base = static_cast<char*>(allocate_chunk_from_tail(size * count, alignment));
+        } catch (const std::bad_alloc&) {
+            FIXED_BLOCK_STAT(++stats.failed_allocations);
+            throw;
+        }
+        // Участок делится на count занятых участков одними заголовками
+        auto* chunk = reinterpret_cast<ChunkHeader*>(base - sizeof(ChunkHeader));
+        for (size_t i = 1; i < count; ++i) {
+            chunk_after(chunk, i * size)->size = size | PREV_IN_USE;
+        }
+        chunk->size = size | (chunk->size & PREV_IN_USE);
+        for (size_t i = 0; i < count; ++i) {
+            FIXED_BLOCK_STAT(record_allocation(bytes, size, 0, false));
+        }
+        return base;
+    }
+
+    char* base;
+    try {
+        base = static_cast<char*>(allocate_from_tail(size * count, alignment));
+    } catch (const std::bad_alloc&) {
+        FIXED_BLOCK_STAT(++stats.failed_allocations);
+        throw;
+    }
+    // allocate_from_tail добавил весь участок последним блоком - режем его на count блоков
+    block_iterator first = std::prev(blocks.end());
+    first->size = size;
+    try {
+        for (size_t i = 1; i < count; ++i) {
+            void* ptr = base + i * size;
+            blocks.push_back({ptr, size, false});
+            block_index.emplace(ptr, std::prev(blocks.end()));
+        }
+    } catch (...) {
+        // Не хватило памяти под метаданные: возвращаем участок целиком
+        while (std::prev(blocks.end()) != first) {
+            block_index.erase(blocks.back().ptr);
+            blocks.pop_back();
+        }
+        first->size = size * count;
+        release_block(first);
+        throw;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        FIXED_BLOCK_STAT(record_allocation(bytes, size, 0, false));
+    }
+    return base;
 }
 
 bool fixed_block_memory_resource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
@@ -61,19 +876,201 @@ bool fixed_block_memory_resource::do_is_equal(const std::pmr::memory_resource& o
 }
 
 size_t fixed_block_memory_resource::get_used_memory() const {
-    return used_bytes;
+    size_t used = 0;
+    for (const auto& arena : arena_chain.arenas) {
+        used += arena.used;
+    }
+    return used;
 }
 
 size_t fixed_block_memory_resource::get_free_memory() const {
-    return pool_size - used_bytes;
+    size_t free = 0;
+    for (const auto& arena : arena_chain.arenas) {
+        // В режиме in_pool конец арены занят барьером
+        size_t capacity = in_block() ? chunk_limit(arena) : arena.size;
+        free += arena.used < capacity ? capacity - arena.used : 0;
+    }
+    return free;
+}
+
+double fixed_block_memory_resource::get_fragmentation() const {
+    // Свободная память: блоки в корзинах и нетронутый "хвост" последней арены
+    const Arena& arena = arena_chain.arenas.back();
+    if (in_block()) {
+        size_t tail = chunk_limit(arena) - arena.used;
+        size_t total_free = tail + chunk_bins->free_bytes;
+        if (total_free == 0) {
+            return 0.0;
+        }
+        // Свободные участки не примыкают к "хвосту": они сливаются с ним
+        size_t largest = tail;
+        size_t top = BIN_COUNT;
+        for (size_t bin = next_bin(chunk_bins->mask, 0); bin < BIN_COUNT; bin = next_bin(chunk_bins->mask, bin + 1)) {
+            top = bin;
+        }
+        if (top < BIN_COUNT) {
+            for (std::uint64_t offset = chunk_bins->heads[top]; offset != NO_CHUNK;
+                 offset = reinterpret_cast<FreeChunk*>(chunk_at(offset))->next) {
+                largest = std::max<size_t>(largest, chunk_at(offset)->size & ~PREV_IN_USE);
+            }
+        }
+        return 1.0 - static_cast<double>(largest) / static_cast<double>(total_free);
+    }
+    size_t tail = arena.size - arena.used;
+    size_t total_free = tail + free_block_bytes;
+    if (total_free == 0) {
+        return 0.0;
+    }
+
+    size_t largest = tail;
+    if (free_block_bytes > 0) {
+        // Наибольший блок лежит в старшей непустой корзине
+        size_t top = BIN_COUNT;
+        for (size_t bin = next_bin(bin_mask, 0); bin < BIN_COUNT; bin = next_bin(bin_mask, bin + 1)) {
+            top = bin;
+        }
+        size_t largest_block = 0;
+        for (block_iterator it = free_bins[top].first; it != blocks.end(); it = it->next_free) {
+            largest_block = std::max(largest_block, it->size);
+        }
+        // Последний свободный блок продолжается "хвостом" арены
+        if (arena.used > 0 && !blocks.empty() && blocks.back().is_free &&
+            static_cast<char*>(blocks.back().ptr) + blocks.back().size == arena.base + arena.used) {
+            largest_block = std::max(largest_block, blocks.back().size + tail);
+        }
+        largest = std::max(largest, largest_block);
+    }
+    return 1.0 - static_cast<double>(largest) / static_cast<double>(total_free);
+}
+
+bool fixed_block_memory_resource::owns(const void* p) const {
+    auto addr = reinterpret_cast<uintptr_t>(p);
+    for (const auto& arena : arena_chain.arenas) {
+        auto base = reinterpret_cast<uintptr_t>(arena.base);
+        if (addr >= base && addr < base + arena.size) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<fixed_block_memory_resource::arena_usage> fixed_block_memory_resource::get_arena_usage() const {
+    std::vector<arena_usage> usage;
+    usage.reserve(arena_chain.arenas.size());
+    for (const auto& arena : arena_chain.arenas) {
+        usage.push_back({arena.base, arena.size, arena.used});
+    }
+    return usage;
+}
+
+void fixed_block_memory_resource::release() {
+    // Все узлы метаданных лежат в metadata_pool: он отдаёт свою память
+    // целиком, а контейнеры создаются заново поверх старых без обхода и
+    // поштучного освобождения узлов. Заголовки участков in_pool просто
+    // забываются вместе с пулом
+    metadata_pool.release();
+    std::construct_at(&blocks, &metadata_pool);
+    std::construct_at(&block_index, &metadata_pool);
+    reset_bins();
+
+    // Первая арена снова пуста, остальные возвращаются upstream
+    for (size_t i = 1; i < arena_chain.arenas.size(); ++i) {
+        arena_chain.upstream->deallocate(arena_chain.arenas[i].base, arena_chain.arenas[i].size, GRANULE);
+    }
+    arena_chain.arenas.resize(1);
+    arena_chain.arenas.front().used = 0;
+    store_tail();
+    if (pool_storage.header) {
+        pool_storage.header->root = 0;
+    }
+
+    // Живых блоков больше нет, накопленные счётчики сохраняются
+    stats.live_bytes = 0;
+    stats.padding_bytes = 0;
+}
+
+void fixed_block_memory_resource::set_root(const void* p) {
+    if (!pool_storage.header) {
+        throw std::logic_error("Root is only stored by backing_store::file");
+    }
+    if (p && !owns(p)) {
+        throw std::invalid_argument("Root must point into the pool");
+    }
+    pool_storage.header->root = p ? static_cast<std::uint64_t>(static_cast<const char*>(p) - memory_pool) + 1 : 0;
+}
+
+void* fixed_block_memory_resource::get_root() const {
+    if (!pool_storage.header || pool_storage.header->root == 0) {
+        return nullptr;
+    }
+    return memory_pool + pool_storage.header->root - 1;
+}
+
+void fixed_block_memory_resource::flush() {
+#if defined(__linux__)
+    if (pool_storage.header && ::msync(pool_storage.header, pool_storage.mapped_size, MS_SYNC) != 0) {
+        throw std::system_error(errno, std::generic_category(), "msync of pool file failed");
+    }
+#endif
+}
+
+bool fixed_block_memory_resource::opened_cleanly() const {
+    return pool_storage.opened_cleanly;
+}
+
+fixed_block_memory_resource::statistics fixed_block_memory_resource::get_statistics() const {
+    return stats;
+}
+
+double fixed_block_memory_resource::statistics::reuse_hit_rate() const {
+    return allocations == 0 ? 0.0 : static_cast<double>(reused_allocations) / static_cast<double>(allocations);
+}
+
+std::string fixed_block_memory_resource::statistics::to_json() const {
+    std::ostringstream out;
+    out << "{\"allocations\":" << allocations
+        << ",\"deallocations\":" << deallocations
+        << ",\"reused_allocations\":" << reused_allocations
+        << ",\"reuse_hit_rate\":" << reuse_hit_rate()
+        << ",\"failed_allocations\":" << failed_allocations
+        << ",\"live_bytes\":" << live_bytes
+        << ",\"peak_live_bytes\":" << peak_live_bytes
+        << ",\"padding_bytes\":" << padding_bytes
+        << ",\"search_length_histogram\":[";
+    for (size_t i = 0; i < search_length_histogram.size(); ++i) {
+        out << (i == 0 ? "" : ",") << search_length_histogram[i];
+    }
+    out << "]}";
+    return out.str();
 }
 
 void fixed_block_memory_resource::print_allocated_blocks() const {
     size_t index = 0;
+    if (in_block()) {
+        // Участки обходятся по заголовкам до "хвоста" или барьера каждой арены
+        for (const auto& arena : arena_chain.arenas) {
+            char* end = arena.base + std::min(arena.used, chunk_limit(arena));
+            for (char* at = arena.base; at < end;) {
+                auto* chunk = reinterpret_cast<ChunkHeader*>(at);
+                size_t size = chunk->size & ~PREV_IN_USE;
+                if (size == 0) {
+                    break;
+                }
+                ChunkHeader* next = chunk_after(chunk, size);
+                bool is_free = reinterpret_cast<char*>(next) != arena.base + arena.used && !(next->size & PREV_IN_USE);
+                std::cout << "Block " << index++
+                          << ": Address=" << static_cast<void*>(at + sizeof(ChunkHeader))
+                          << ", Size=" << size
+                          << ", " << (is_free ? "Free" : "Allocated") << "\n";
+                at += size;
+            }
+        }
+        return;
+    }
     for (const auto& block : blocks) {
         std::cout << "Block " << index++
                   << ": Address=" << block.ptr
                   << ", Size=" << block.size
                   << ", " << (block.is_free ? "Free" : "Allocated") << "\n";
     }
-}
\ No newline at end of file
+}
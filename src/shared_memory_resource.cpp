@@ -0,0 +1,388 @@
+#include "../include/shared_memory_resource.h"
+#include <atomic>
+#include <cerrno>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#if defined(__linux__)
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr std::uint64_t SEGMENT_MAGIC{0x32414235484D5350ULL}; // "PSHM5BA2"
+    // Корзины блоков до SMALL_CLASSES * GRANULE байт; более крупные - в одном списке
+    constexpr size_t SMALL_CLASSES{64};
+    constexpr std::uint64_t IN_USE{1}; // Младший бит размера: блок занят
+
+    uintptr_t align_up(uintptr_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    // Заголовок перед каждым блоком сегмента (граничный тег). Размер включает
+    // заголовок; prev_size - размер физически предыдущего блока, 0 у первого.
+    // По ним освобождение находит соседей и сливает свободные блоки
+    struct BlockHeader {
+        std::uint64_t size;
+        std::uint64_t prev_size;
+    };
+
+    // Свободный блок: за заголовком хранятся смещения соседей по корзине, 0 - нет соседа
+    struct FreeBlock {
+        BlockHeader header;
+        std::uint64_t next;
+        std::uint64_t prev;
+    };
+
+    constexpr std::uint64_t HEADER_SIZE{sizeof(BlockHeader)};
+    constexpr std::uint64_t MIN_BLOCK{sizeof(FreeBlock)};
+}
+
+#if defined(__linux__)
+// Заголовок в начале сегмента. Смещение 0 занято им, поэтому 0 означает "нет блока"
+struct shared_memory_resource::SegmentHeader {
+    std::uint64_t magic; // Записывается последним: сегмент готов к открытию
+    std::uint64_t size;
+    std::uint64_t used; // "Хвост" сегмента
+    std::uint64_t last_size; // Размер блока, примыкающего к "хвосту"; 0 - блоков нет
+    std::uint64_t root;
+    std::uint64_t large_free;
+    std::uint64_t free_lists[SMALL_CLASSES];
+    pthread_mutex_t lock; // PTHREAD_PROCESS_SHARED и PTHREAD_MUTEX_ROBUST
+};
+
+namespace {
+    // Захват межпроцессного мьютекса. Если владелец умер, удерживая мьютекс,
+    // мьютекс восстанавливается, но операция, прерванная в нём, не откатывается
+    class segment_guard {
+        private:
+            pthread_mutex_t* mutex;
+
+        public:
+            explicit segment_guard(pthread_mutex_t* m) : mutex(m) {
+                int result = ::pthread_mutex_lock(mutex);
+                if (result == EOWNERDEAD) {
+                    ::pthread_mutex_consistent(mutex);
+                } else if (result != 0) {
+                    throw std::system_error(result, std::generic_category(), "Lock of shared segment failed");
+                }
+            }
+            ~segment_guard() {
+                ::pthread_mutex_unlock(mutex);
+            }
+
+            segment_guard(const segment_guard&) = delete;
+            segment_guard& operator=(const segment_guard&) = delete;
+    };
+}
+
+const size_t shared_memory_resource::POOL_OFFSET{(sizeof(SegmentHeader) + 63) & ~size_t{63}};
+
+shared_memory_resource::shared_memory_resource(const std::string& segment_name, size_t size)
+    : segment(nullptr), segment_size(0), name(segment_name), creator(::getpid()) {
+    int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "shm_open of shared segment failed");
+    }
+    map_segment(fd, size, true);
+}
+
+shared_memory_resource::shared_memory_resource(const std::string& segment_name)
+    : segment(nullptr), segment_size(0), name(segment_name), creator(0) {
+    int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "shm_open of shared segment failed");
+    }
+    map_segment(fd, 0, false);
+}
+
+shared_memory_resource::shared_memory_resource(size_t size)
+    : segment(nullptr), segment_size(0), creator(::getpid()) {
+    int fd = ::memfd_create("shared_memory_resource", MFD_CLOEXEC);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "memfd_create of shared segment failed");
+    }
+    map_segment(fd, size, true);
+}
+
+shared_memory_resource::~shared_memory_resource() {
+    ::munmap(segment, segment_size);
+    if (!name.empty() && creator == ::getpid()) {
+        ::shm_unlink(name.c_str());
+    }
+}
+
+void shared_memory_resource::map_segment(int fd, size_t size, bool create) {
+    // Отображение переживает дескриптор, поэтому он закрывается при любом исходе
+    auto fail = [&](int error, const char* message) {
+        ::close(fd);
+        if (create && !name.empty()) {
+            ::shm_unlink(name.c_str());
+        }
+        throw std::system_error(error, std::generic_category(), message);
+    };
+    if (create) {
+        size &= ~(GRANULE - 1);
+        if (size <= POOL_OFFSET) {
+            fail(EINVAL, "Shared segment is too small");
+        }
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            fail(errno, "ftruncate of shared segment failed");
+        }
+    } else {
+        struct stat segment_stat;
+        if (::fstat(fd, &segment_stat) != 0) {
+            fail(errno, "fstat of shared segment failed");
+        }
+        size = static_cast<size_t>(segment_stat.st_size);
+        if (size <= POOL_OFFSET) {
+            fail(EINVAL, "Shared segment is not initialized");
+        }
+    }
+    void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        fail(errno, "mmap of shared segment failed");
+    }
+    ::close(fd);
+    segment = static_cast<char*>(mapping);
+    segment_size = size;
+
+    SegmentHeader* h = header();
+    if (!create) {
+        if (std::atomic_ref<std::uint64_t>(h->magic).load(std::memory_order_acquire) != SEGMENT_MAGIC || h->size != size) {
+            ::munmap(mapping, size);
+            throw std::invalid_argument("Shared segment is not initialized");
+        }
+        return;
+    }
+
+    // Новый сегмент заполнен нулями: пустые корзины и нет корня
+    h->size = size;
+    h->used = POOL_OFFSET;
+    pthread_mutexattr_t attributes;
+    ::pthread_mutexattr_init(&attributes);
+    ::pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+    ::pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+    int result = ::pthread_mutex_init(&h->lock, &attributes);
+    ::pthread_mutexattr_destroy(&attributes);
+    if (result != 0) {
+        ::munmap(mapping, size);
+        if (!name.empty()) {
+            ::shm_unlink(name.c_str());
+        }
+        throw std::system_error(result, std::generic_category(), "Initialization of shared mutex failed");
+    }
+    std::atomic_ref<std::uint64_t>(h->magic).store(SEGMENT_MAGIC, std::memory_order_release);
+}
+
+std::uint64_t& shared_memory_resource::bin_of(std::uint64_t size) {
+    SegmentHeader* h = header();
+    size_t index = size / GRANULE - 1;
+    return index < SMALL_CLASSES ? h->free_lists[index] : h->large_free;
+}
+
+void shared_memory_resource::push_free(std::uint64_t offset, std::uint64_t size) {
+    auto* block = reinterpret_cast<FreeBlock*>(segment + offset);
+    std::uint64_t& list = bin_of(size);
+    block->header.size = size;
+    block->prev = 0;
+    block->next = list;
+    if (list) {
+        reinterpret_cast<FreeBlock*>(segment + list)->prev = offset;
+    }
+    list = offset;
+}
+
+void shared_memory_resource::unlink_free(std::uint64_t offset) {
+    auto* block = reinterpret_cast<FreeBlock*>(segment + offset);
+    if (block->prev) {
+        reinterpret_cast<FreeBlock*>(segment + block->prev)->next = block->next;
+    } else {
+        bin_of(block->header.size) = block->next;
+    }
+    if (block->next) {
+        reinterpret_cast<FreeBlock*>(segment + block->next)->prev = block->prev;
+    }
+}
+
+void shared_memory_resource::set_prev_size(std::uint64_t offset, std::uint64_t size) {
+    SegmentHeader* h = header();
+    if (offset < h->used) {
+        reinterpret_cast<BlockHeader*>(segment + offset)->prev_size = size;
+    } else {
+        h->last_size = size;
+    }
+}
+
+void* shared_memory_resource::take_block(std::uint64_t offset, std::uint64_t size) {
+    // Остаток, в который помещается свободный блок, возвращается в корзины
+    auto* block = reinterpret_cast<BlockHeader*>(segment + offset);
+    std::uint64_t rest = block->size - size;
+    if (rest >= MIN_BLOCK) {
+        block->size = size;
+        auto* rest_block = reinterpret_cast<BlockHeader*>(segment + offset + size);
+        rest_block->prev_size = size;
+        set_prev_size(offset + size + rest, rest);
+        push_free(offset + size, rest);
+    }
+    block->size |= IN_USE;
+    return segment + offset + HEADER_SIZE;
+}
+
+void* shared_memory_resource::do_allocate(size_t bytes, size_t alignment) {
+    if (alignment > GRANULE) {
+        throw std::invalid_argument("shared_memory_resource supports alignment up to alignof(max_align_t)");
+    }
+    std::uint64_t size = align_up(bytes == 0 ? 1 : bytes, GRANULE) + HEADER_SIZE;
+    SegmentHeader* h = header();
+    segment_guard guard(&h->lock);
+
+    // Наименьшая непустая точная корзина; блоки в ней не меньше запроса
+    for (size_t index = size / GRANULE - 1; index < SMALL_CLASSES; ++index) {
+        if (std::uint64_t offset = h->free_lists[index]) {
+            unlink_free(offset);
+            return take_block(offset, size);
+        }
+    }
+    // First-fit среди крупных блоков
+    for (std::uint64_t offset = h->large_free; offset; offset = reinterpret_cast<FreeBlock*>(segment + offset)->next) {
+        if (reinterpret_cast<BlockHeader*>(segment + offset)->size >= size) {
+            unlink_free(offset);
+            return take_block(offset, size);
+        }
+    }
+
+    // Если подходящего свободного блока нет, выделяем из "хвоста" сегмента
+    if (h->size - h->used < size) {
+        throw std::bad_alloc();
+    }
+    std::uint64_t offset = h->used;
+    auto* block = reinterpret_cast<BlockHeader*>(segment + offset);
+    block->size = size | IN_USE;
+    block->prev_size = h->last_size;
+    h->used += size;
+    h->last_size = size;
+    return segment + offset + HEADER_SIZE;
+}
+
+void shared_memory_resource::do_deallocate(void* p, size_t bytes, size_t) {
+    char* ptr = static_cast<char*>(p);
+    if (ptr < segment + POOL_OFFSET + HEADER_SIZE || ptr >= segment + segment_size ||
+        (ptr - segment) % GRANULE != 0) {
+        throw std::invalid_argument("Pointer not allocated by this memory resource");
+    }
+    SegmentHeader* h = header();
+    segment_guard guard(&h->lock);
+
+    // Заголовок проверяется под мьютексом: состояние блока меняют и другие процессы
+    std::uint64_t offset = static_cast<std::uint64_t>(ptr - segment) - HEADER_SIZE;
+    auto* block = reinterpret_cast<BlockHeader*>(segment + offset);
+    std::uint64_t size = block->size & ~IN_USE;
+    std::uint64_t requested = align_up(bytes == 0 ? 1 : bytes, GRANULE) + HEADER_SIZE;
+    if (offset + size > h->used || size < requested || size - requested >= MIN_BLOCK) {
+        throw std::invalid_argument("Pointer not allocated by this memory resource");
+    }
+    if (!(block->size & IN_USE)) {
+        throw std::invalid_argument("Block already deallocated");
+    }
+    // Признак снимается сразу: заголовок блока, поглощённого соседом, остаётся
+    // в памяти и при повторном освобождении покажет, что блок свободен
+    block->size = size;
+
+    // Сливаем блок со свободными физическими соседями
+    if (block->prev_size != 0) {
+        std::uint64_t prev = offset - block->prev_size;
+        auto* prev_block = reinterpret_cast<BlockHeader*>(segment + prev);
+        if (!(prev_block->size & IN_USE)) {
+            unlink_free(prev);
+            size += prev_block->size;
+            offset = prev;
+            block = prev_block;
+        }
+    }
+    std::uint64_t next = offset + size;
+    if (next == h->used) {
+        // Блок примыкает к "хвосту" и возвращается в него
+        h->used = offset;
+        h->last_size = block->prev_size;
+        block->size = size;
+        return;
+    }
+    auto* next_block = reinterpret_cast<BlockHeader*>(segment + next);
+    if (!(next_block->size & IN_USE)) {
+        unlink_free(next);
+        size += next_block->size;
+        if (offset + size == h->used) {
+            h->used = offset;
+            h->last_size = block->prev_size;
+            block->size = size;
+            return;
+        }
+    }
+    set_prev_size(offset + size, size);
+    push_free(offset, size);
+}
+
+size_t shared_memory_resource::get_used_memory() const {
+    segment_guard guard(&header()->lock);
+    return header()->used;
+}
+
+void shared_memory_resource::set_root(const void* p) {
+    if (p && !owns(p)) {
+        throw std::invalid_argument("Root must point into the segment");
+    }
+    segment_guard guard(&header()->lock);
+    header()->root = p ? static_cast<std::uint64_t>(static_cast<const char*>(p) - segment) : 0;
+}
+
+void* shared_memory_resource::get_root() const {
+    segment_guard guard(&header()->lock);
+    return header()->root ? segment + header()->root : nullptr;
+}
+#else
+shared_memory_resource::shared_memory_resource(const std::string&, size_t) {
+    throw std::invalid_argument("shared_memory_resource is not supported on this platform");
+}
+shared_memory_resource::shared_memory_resource(const std::string&) {
+    throw std::invalid_argument("shared_memory_resource is not supported on this platform");
+}
+shared_memory_resource::shared_memory_resource(size_t) {
+    throw std::invalid_argument("shared_memory_resource is not supported on this platform");
+}
+shared_memory_resource::~shared_memory_resource() = default;
+void shared_memory_resource::map_segment(int, size_t, bool) {}
+std::uint64_t& shared_memory_resource::bin_of(std::uint64_t) {
+    throw std::logic_error("shared_memory_resource is not supported on this platform");
+}
+void shared_memory_resource::push_free(std::uint64_t, std::uint64_t) {}
+void shared_memory_resource::unlink_free(std::uint64_t) {}
+void shared_memory_resource::set_prev_size(std::uint64_t, std::uint64_t) {}
+void* shared_memory_resource::take_block(std::uint64_t, std::uint64_t) {
+    return nullptr;
+}
+void* shared_memory_resource::do_allocate(size_t, size_t) {
+    throw std::bad_alloc();
+}
+void shared_memory_resource::do_deallocate(void*, size_t, size_t) {}
+size_t shared_memory_resource::get_used_memory() const {
+    return 0;
+}
+void shared_memory_resource::set_root(const void*) {}
+void* shared_memory_resource::get_root() const {
+    return nullptr;
+}
+#endif
+
+bool shared_memory_resource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other; // Сравнение по адресу
+}
+
+bool shared_memory_resource::owns(const void* p) const {
+    auto addr = reinterpret_cast<uintptr_t>(p);
+    auto base = reinterpret_cast<uintptr_t>(segment);
+    return addr >= base && addr < base + segment_size;
+}
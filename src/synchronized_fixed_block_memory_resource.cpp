@@ -0,0 +1,247 @@
+#include "../include/synchronized_fixed_block_memory_resource.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+    std::atomic<std::uint64_t> next_resource_id{1};
+}
+
+// Кэши одного потока. Последний использованный кэш запоминается, поэтому
+// быстрый путь для одного ресурса - сравнение идентификатора
+struct synchronized_fixed_block_memory_resource::ThreadCacheSet {
+    std::vector<std::unique_ptr<ThreadCache>> caches;
+    ThreadCache* last{nullptr};
+    std::uint64_t last_id{0};
+
+    ~ThreadCacheSet() {
+        // Поток завершается: блоки из его магазинов возвращаются живым ресурсам
+        std::lock_guard<std::mutex> registry_guard(registry_lock());
+        for (auto& cache : caches) {
+            synchronized_fixed_block_memory_resource* owner = cache->owner;
+            if (!owner) {
+                continue;
+            }
+            {
+                std::lock_guard<std::mutex> guard(owner->central_lock);
+                owner->flush_cache(*cache);
+            }
+            std::erase(owner->thread_caches, cache.get());
+        }
+    }
+};
+
+std::mutex& synchronized_fixed_block_memory_resource::registry_lock() {
+    static std::mutex lock;
+    return lock;
+}
+
+synchronized_fixed_block_memory_resource::synchronized_fixed_block_memory_resource(size_t size)
+    : central(size), id(next_resource_id.fetch_add(1, std::memory_order_relaxed)) {}
+
+synchronized_fixed_block_memory_resource::~synchronized_fixed_block_memory_resource() {
+    // Магазины потоков ссылаются на память пула, которая сейчас исчезнет
+    std::lock_guard<std::mutex> registry_guard(registry_lock());
+    for (ThreadCache* cache : thread_caches) {
+        cache->owner = nullptr;
+    }
+}
+
+synchronized_fixed_block_memory_resource::ThreadCache& synchronized_fixed_block_memory_resource::local_cache() {
+    thread_local ThreadCacheSet set;
+    if (set.last_id == id) {
+        return *set.last;
+    }
+
+    std::lock_guard<std::mutex> registry_guard(registry_lock());
+    // Кэши разрушенных ресурсов больше не нужны
+    std::erase_if(set.caches, [](const auto& cache) { return cache->owner == nullptr; });
+    auto found = std::find_if(set.caches.begin(), set.caches.end(),
+                              [this](const auto& cache) { return cache->owner_id == id; });
+    ThreadCache* cache;
+    if (found != set.caches.end()) {
+        cache = found->get();
+    } else {
+        set.caches.push_back(std::make_unique<ThreadCache>());
+        cache = set.caches.back().get();
+        cache->owner = this;
+        cache->owner_id = id;
+        try {
+            thread_caches.push_back(cache);
+        } catch (...) {
+            set.caches.pop_back();
+            throw;
+        }
+    }
+    set.last = cache;
+    set.last_id = id;
+    return *cache;
+}
+
+synchronized_fixed_block_memory_resource::Magazine& synchronized_fixed_block_memory_resource::find_magazine(
+        ThreadCache& cache, size_t bytes, size_t alignment) {
+    for (auto& magazine : cache.magazines) {
+        if (magazine.size == bytes && magazine.alignment == alignment) {
+            return magazine;
+        }
+    }
+    Magazine& magazine = cache.magazines.emplace_back();
+    magazine.size = bytes;
+    magazine.alignment = alignment;
+    return magazine;
+}
+
+void synchronized_fixed_block_memory_resource::mark_freed(void* p) const {
+    auto* words = static_cast<std::uint64_t*>(p);
+    std::atomic_ref<std::uint64_t>(words[0]).store(FREED_TAG, std::memory_order_relaxed);
+    std::atomic_ref<std::uint64_t>(words[1]).store(reinterpret_cast<uintptr_t>(p) ^ id, std::memory_order_relaxed);
+}
+
+void synchronized_fixed_block_memory_resource::clear_mark(void* p) const {
+    auto* words = static_cast<std::uint64_t*>(p);
+    std::atomic_ref<std::uint64_t>(words[0]).store(0, std::memory_order_relaxed);
+}
+
+bool synchronized_fixed_block_memory_resource::is_marked(const void* p) const {
+    auto* words = static_cast<std::uint64_t*>(const_cast<void*>(p));
+    return std::atomic_ref<std::uint64_t>(words[0]).load(std::memory_order_relaxed) == FREED_TAG &&
+           std::atomic_ref<std::uint64_t>(words[1]).load(std::memory_order_relaxed) == (reinterpret_cast<uintptr_t>(p) ^ id);
+}
+
+void synchronized_fixed_block_memory_resource::flush_cache(ThreadCache& cache) {
+    // Метки остаются: повторное освобождение блока из пула тоже будет замечено
+    for (auto& magazine : cache.magazines) {
+        while (magazine.count > 0) {
+            central.deallocate(magazine.blocks[--magazine.count], magazine.size, magazine.alignment);
+        }
+    }
+    cache.drain_requested.store(false, std::memory_order_relaxed);
+}
+
+void synchronized_fixed_block_memory_resource::drain_caches() {
+    // Чужие магазины без мьютекса недоступны: их потоки вернут блоки сами
+    // при следующем обращении к ресурсу или при завершении
+    ThreadCache& own = local_cache();
+    std::lock_guard<std::mutex> registry_guard(registry_lock());
+    for (ThreadCache* cache : thread_caches) {
+        if (cache != &own) {
+            cache->drain_requested.store(true, std::memory_order_relaxed);
+        }
+    }
+    std::lock_guard<std::mutex> guard(central_lock);
+    flush_cache(own);
+}
+
+void* synchronized_fixed_block_memory_resource::do_allocate(size_t bytes, size_t alignment) {
+    try {
+        return allocate_cached(bytes, alignment);
+    } catch (const std::bad_alloc&) {
+        // Свободные блоки могли осесть в магазинах: возвращаем их в пул и пробуем снова
+        drain_caches();
+        std::lock_guard<std::mutex> guard(central_lock);
+        void* ptr = central.allocate(bytes, alignment);
+        if (bytes <= MAX_CACHED_SIZE) {
+            clear_mark(ptr);
+        }
+        return ptr;
+    }
+}
+
+void* synchronized_fixed_block_memory_resource::allocate_cached(size_t bytes, size_t alignment) {
+    if (bytes > MAX_CACHED_SIZE) {
+        std::lock_guard<std::mutex> guard(central_lock);
+        return central.allocate(bytes, alignment);
+    }
+
+    ThreadCache& cache = local_cache();
+    if (cache.drain_requested.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> guard(central_lock);
+        flush_cache(cache);
+    }
+    Magazine& magazine = find_magazine(cache, bytes, alignment);
+    if (magazine.count == 0) {
+        // Пополняем магазин из общего пула за один захват мьютекса
+        std::lock_guard<std::mutex> guard(central_lock);
+        void* ptr = central.allocate(bytes, alignment);
+        try {
+            while (magazine.count < MAGAZINE_CAPACITY / 2) {
+                void* block = central.allocate(bytes, alignment);
+                mark_freed(block);
+                magazine.blocks[magazine.count++] = block;
+            }
+        } catch (const std::bad_alloc&) {
+            // Пул почти исчерпан: хватило хотя бы на текущий запрос
+        }
+        clear_mark(ptr);
+        return ptr;
+    }
+    void* ptr = magazine.blocks[--magazine.count];
+    clear_mark(ptr);
+    return ptr;
+}
+
+void synchronized_fixed_block_memory_resource::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    // Блоки общего пула начинаются с границы гранулы
+    if (!central.owns(p) || reinterpret_cast<uintptr_t>(p) % alignof(std::max_align_t) != 0) {
+        throw std::invalid_argument("Pointer not allocated by this memory resource");
+    }
+    if (bytes > MAX_CACHED_SIZE) {
+        std::lock_guard<std::mutex> guard(central_lock);
+        central.deallocate(p, bytes, alignment);
+        return;
+    }
+    // Блок уже лежит в чьём-то магазине или возвращён из магазина в пул
+    if (is_marked(p)) {
+        throw std::invalid_argument("Block already deallocated");
+    }
+
+    ThreadCache& cache = local_cache();
+    if (cache.drain_requested.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> guard(central_lock);
+        flush_cache(cache);
+    }
+    Magazine& magazine = find_magazine(cache, bytes, alignment);
+    if (magazine.count == MAGAZINE_CAPACITY) {
+        // Магазин полон: возвращаем половину блоков в общий пул
+        std::lock_guard<std::mutex> guard(central_lock);
+        while (magazine.count > MAGAZINE_CAPACITY / 2) {
+            central.deallocate(magazine.blocks[--magazine.count], bytes, alignment);
+        }
+    }
+    mark_freed(p);
+    magazine.blocks[magazine.count++] = p;
+}
+
+bool synchronized_fixed_block_memory_resource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other; // Сравнение по адресу
+}
+
+void synchronized_fixed_block_memory_resource::release() {
+    // Магазины других потоков трогаются напрямую: одновременных выделений нет
+    std::lock_guard<std::mutex> registry_guard(registry_lock());
+    for (ThreadCache* cache : thread_caches) {
+        for (auto& magazine : cache->magazines) {
+            magazine.count = 0;
+        }
+        cache->drain_requested.store(false, std::memory_order_relaxed);
+    }
+    std::lock_guard<std::mutex> guard(central_lock);
+    central.release();
+}
+
+size_t synchronized_fixed_block_memory_resource::get_used_memory() const {
+    std::lock_guard<std::mutex> guard(central_lock);
+    return central.get_used_memory();
+}
+
+size_t synchronized_fixed_block_memory_resource::get_free_memory() const {
+    std::lock_guard<std::mutex> guard(central_lock);
+    return central.get_free_memory();
+}
+
+fixed_block_memory_resource::statistics synchronized_fixed_block_memory_resource::get_statistics() const {
+    std::lock_guard<std::mutex> guard(central_lock);
+    return central.get_statistics();
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "../include/concurrent_deque.h"
+#include "../include/synchronized_fixed_block_memory_resource.h"
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Тест 1: Однопоточная семантика двусторонней очереди
+TEST(ConcurrentDequeTest, SingleThread) {
+    synchronized_fixed_block_memory_resource mr(64 * 1024);
+    concurrent_deque<std::string> deque(&mr);
+    EXPECT_TRUE(deque.empty());
+    EXPECT_FALSE(deque.try_pop_front().has_value());
+    EXPECT_FALSE(deque.try_pop_back().has_value());
+
+    deque.push_back("b");
+    deque.push_front("a");
+    deque.emplace_back(3, 'c');
+    deque.emplace_front("z");
+    EXPECT_EQ(deque.size(), 4);
+
+    EXPECT_EQ(deque.try_pop_front().value(), "z");
+    EXPECT_EQ(deque.try_pop_back().value(), "ccc");
+    EXPECT_EQ(deque.try_pop_back().value(), "b");
+    EXPECT_EQ(deque.try_pop_front().value(), "a");
+    EXPECT_TRUE(deque.empty());
+
+    for (int i = 0; i < 10; ++i) {
+        deque.push_back(std::to_string(i));
+    }
+    deque.clear();
+    EXPECT_TRUE(deque.empty());
+    EXPECT_FALSE(deque.try_pop_front().has_value());
+}
+
+// Тест 2: Производители и потребители: каждый элемент извлекается ровно один раз
+TEST(ConcurrentDequeTest, ProducersConsumers) {
+    synchronized_fixed_block_memory_resource mr(4 * 1024 * 1024);
+    concurrent_deque<int> deque(&mr);
+    constexpr int PRODUCERS = 4;
+    constexpr int CONSUMERS = 4;
+    constexpr int PER_PRODUCER = 5000;
+
+    std::atomic<int> produced_done{0};
+    std::vector<std::vector<int>> consumed(CONSUMERS);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < PER_PRODUCER; ++i) {
+                // Половина элементов с каждого конца
+                if (i % 2 == 0) {
+                    deque.push_back(p * PER_PRODUCER + i);
+                } else {
+                    deque.push_front(p * PER_PRODUCER + i);
+                }
+            }
+            ++produced_done;
+        });
+    }
+    for (int c = 0; c < CONSUMERS; ++c) {
+        threads.emplace_back([&, c] {
+            while (true) {
+                bool finished = produced_done.load() == PRODUCERS;
+                auto value = c % 2 == 0 ? deque.try_pop_front() : deque.try_pop_back();
+                if (value) {
+                    consumed[c].push_back(*value);
+                } else if (finished) {
+                    break;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<int> all;
+    for (const auto& part : consumed) {
+        all.insert(all.end(), part.begin(), part.end());
+    }
+    std::sort(all.begin(), all.end());
+    ASSERT_EQ(all.size(), static_cast<size_t>(PRODUCERS * PER_PRODUCER));
+    for (int i = 0; i < PRODUCERS * PER_PRODUCER; ++i) {
+        EXPECT_EQ(all[i], i);
+    }
+    EXPECT_TRUE(deque.empty());
+}
+
+// Тест 3: Очередь колеблется около пустой, когда концам нужны оба мьютекса
+TEST(ConcurrentDequeTest, NearEmptyContention) {
+    synchronized_fixed_block_memory_resource mr(1024 * 1024);
+    concurrent_deque<int> deque(&mr);
+    constexpr int ITERATIONS = 20000;
+    std::atomic<long long> pushed_sum{0};
+    std::atomic<long long> popped_sum{0};
+
+    auto worker = [&](bool front) {
+        for (int i = 1; i <= ITERATIONS; ++i) {
+            if (front) {
+                deque.push_front(i);
+            } else {
+                deque.push_back(i);
+            }
+            pushed_sum += i;
+            auto value = front ? deque.try_pop_back() : deque.try_pop_front();
+            if (value) {
+                popped_sum += *value;
+            }
+        }
+    };
+    std::thread a(worker, true);
+    std::thread b(worker, false);
+    a.join();
+    b.join();
+
+    while (auto value = deque.try_pop_front()) {
+        popped_sum += *value;
+    }
+    EXPECT_EQ(pushed_sum.load(), popped_sum.load());
+    EXPECT_TRUE(deque.empty());
+}
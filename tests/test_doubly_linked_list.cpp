@@ -1,6 +1,14 @@
 #include <gtest/gtest.h>
 #include "../include/doubly_linked_list.h"
 #include "../include/fixed_block_memory_resource.h"
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <utility>
+#include <numeric>
+#include <ranges>
+#include <sstream>
+#include <iterator>
 
 // Тест 1: Создание списка
 TEST(DoublyLinkedListTest, Construction) {
@@ -230,3 +238,650 @@ TEST(DoublyLinkedListTest, MemoryReuse) {
     // Память не должна сильно вырасти (переиспользование)
     EXPECT_LE(used_after_reuse, used_after_push + 100); // Небольшой запас на выравнивание
 }
+
+// Тест 15: discard забывает узлы без освобождения
+TEST(DoublyLinkedListTest, Discard) {
+    fixed_block_memory_resource mr(1024);
+    doubly_linked_list<int> list(&mr);
+
+    list.push_back(10);
+    list.push_back(20);
+    size_t used = mr.get_used_memory();
+
+    list.discard();
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.begin(), list.end());
+    EXPECT_EQ(mr.get_used_memory(), used); // Память вернётся только через release()
+
+    mr.release();
+    list.push_back(30);
+    EXPECT_EQ(*list.begin(), 30);
+}
+
+// Тип, считающий свои копирования и перемещения
+struct CopyCounter {
+    static inline int copies = 0;
+    static inline int moves = 0;
+    int value;
+
+    explicit CopyCounter(int v) : value(v) {}
+    CopyCounter(const CopyCounter& other) : value(other.value) { ++copies; }
+    CopyCounter(CopyCounter&& other) noexcept : value(other.value) { ++moves; }
+    CopyCounter& operator=(const CopyCounter& other) {
+        value = other.value;
+        ++copies;
+        return *this;
+    }
+    CopyCounter& operator=(CopyCounter&& other) noexcept {
+        value = other.value;
+        ++moves;
+        return *this;
+    }
+
+    static void reset() {
+        copies = 0;
+        moves = 0;
+    }
+};
+
+// Тест 16: push_back/push_front с rvalue перемещают, а не копируют
+TEST(DoublyLinkedListTest, PushMovesRvalues) {
+    fixed_block_memory_resource mr(1024);
+    doubly_linked_list<CopyCounter> list(&mr);
+    CopyCounter::reset();
+
+    list.push_back(CopyCounter(1));
+    list.push_front(CopyCounter(0));
+    EXPECT_EQ(CopyCounter::copies, 0);
+    EXPECT_EQ(CopyCounter::moves, 2);
+
+    CopyCounter lvalue(2);
+    list.push_back(lvalue);
+    EXPECT_EQ(CopyCounter::copies, 1);
+}
+
+// Тест 17: emplace_back/emplace_front/emplace конструируют элемент на месте
+TEST(DoublyLinkedListTest, EmplaceConstructsInPlace) {
+    fixed_block_memory_resource mr(1024);
+    doubly_linked_list<CopyCounter> list(&mr);
+    CopyCounter::reset();
+
+    list.emplace_back(2);
+    list.emplace_front(0);
+    auto pos = list.begin();
+    ++pos;
+    auto inserted = list.emplace(pos, 1);
+    list.emplace(list.end(), 3);
+    EXPECT_EQ(CopyCounter::copies, 0);
+    EXPECT_EQ(CopyCounter::moves, 0);
+
+    EXPECT_EQ(inserted->value, 1);
+    EXPECT_EQ(list.emplace_back(4).value, 4);
+    EXPECT_EQ(list.size(), 5);
+    int expected = 0;
+    for (const auto& item : list) {
+        EXPECT_EQ(item.value, expected++);
+    }
+}
+
+// Тип, конструктор которого бросает исключение
+struct ThrowingValue {
+    explicit ThrowingValue(bool fail) {
+        if (fail) {
+            throw std::runtime_error("construction failed");
+        }
+    }
+};
+
+// Тест 18: Неудачное конструирование не оставляет узел в списке и в пуле
+TEST(DoublyLinkedListTest, EmplaceExceptionSafety) {
+    fixed_block_memory_resource mr(1024);
+    doubly_linked_list<ThrowingValue> list(&mr);
+
+    list.emplace_back(false);
+    EXPECT_THROW(list.emplace_back(true), std::runtime_error);
+    EXPECT_EQ(list.size(), 1);
+    // Память неудачного узла возвращена и переиспользуется
+    size_t used = mr.get_used_memory();
+    list.emplace_back(false);
+    EXPECT_EQ(mr.get_used_memory(), used);
+}
+
+// Собирает элементы списка в вектор для сравнения
+template <typename T>
+std::vector<T> to_vector(const doubly_linked_list<T>& list) {
+    return std::vector<T>(list.begin(), list.end());
+}
+
+// Тест 19: insert и erase в середине списка
+TEST(DoublyLinkedListTest, InsertErase) {
+    fixed_block_memory_resource mr(1024);
+    doubly_linked_list<int> list(&mr);
+    list.push_back(1);
+    list.push_back(3);
+
+    auto it = list.insert(std::next(list.begin()), 2);
+    EXPECT_EQ(*it, 2);
+    int value = 4;
+    list.insert(list.end(), std::move(value));
+    list.insert(list.begin(), 0);
+    EXPECT_EQ(to_vector(list), (std::vector<int>{0, 1, 2, 3, 4}));
+
+    auto next = list.erase(std::next(list.begin(), 2));
+    EXPECT_EQ(*next, 3);
+    EXPECT_EQ(list.erase(std::prev(list.end())), list.end());
+    list.erase(list.begin());
+    EXPECT_EQ(to_vector(list), (std::vector<int>{1, 3}));
+    EXPECT_EQ(list.size(), 2);
+    // Удаление последнего оставшегося элемента обнуляет head и tail
+    list.erase(list.begin());
+    list.erase(list.begin());
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.begin(), list.end());
+}
+
+// Тест 20: erase диапазона и remove_if возвращают память ресурсу
+TEST(DoublyLinkedListTest, EraseRangeRemoveIf) {
+    fixed_block_memory_resource mr(4096);
+    doubly_linked_list<int> list(&mr);
+    for (int i = 0; i < 10; ++i) {
+        list.push_back(i);
+    }
+
+    auto last = list.erase(std::next(list.begin(), 2), std::next(list.begin(), 5));
+    EXPECT_EQ(*last, 5);
+    EXPECT_EQ(to_vector(list), (std::vector<int>{0, 1, 5, 6, 7, 8, 9}));
+
+    EXPECT_EQ(list.remove_if([](int x) { return x % 2 == 1; }), 4);
+    EXPECT_EQ(to_vector(list), (std::vector<int>{0, 6, 8}));
+    EXPECT_EQ(list.size(), 3);
+
+    list.erase(list.begin(), list.end());
+    EXPECT_TRUE(list.empty());
+    // Освобождённые узлы переиспользуются - пул не растёт
+    size_t used = mr.get_used_memory();
+    for (int i = 0; i < 10; ++i) {
+        list.push_back(i);
+    }
+    EXPECT_EQ(mr.get_used_memory(), used);
+}
+
+// Тест 21: splice всего списка перевешивает узлы без выделений
+TEST(DoublyLinkedListTest, SpliceWholeList) {
+    fixed_block_memory_resource mr(4096);
+    doubly_linked_list<int> a(&mr);
+    doubly_linked_list<int> b(&mr);
+    a.push_back(1);
+    a.push_back(4);
+    b.push_back(2);
+    b.push_back(3);
+    const int* moved = &*b.begin();
+
+    size_t used = mr.get_used_memory();
+    a.splice(std::next(a.begin()), b);
+    EXPECT_EQ(mr.get_used_memory(), used);
+    EXPECT_EQ(to_vector(a), (std::vector<int>{1, 2, 3, 4}));
+    EXPECT_EQ(a.size(), 4);
+    EXPECT_TRUE(b.empty());
+    // Узел остался тем же - элемент не копировался
+    EXPECT_EQ(&*std::next(a.begin()), moved);
+
+    // splice в пустой список и из пустого
+    doubly_linked_list<int> c(&mr);
+    c.splice(c.end(), a);
+    c.splice(c.begin(), b);
+    EXPECT_EQ(to_vector(c), (std::vector<int>{1, 2, 3, 4}));
+    EXPECT_EQ(*std::prev(c.end()), 4);
+}
+
+// Тест 22: splice одного узла и диапазона, в том числе внутри списка
+TEST(DoublyLinkedListTest, SpliceElementAndRange) {
+    fixed_block_memory_resource mr(4096);
+    doubly_linked_list<int> a(&mr);
+    doubly_linked_list<int> b(&mr);
+    for (int i = 0; i < 3; ++i) {
+        a.push_back(i);
+        b.push_back(10 + i);
+    }
+
+    a.splice(a.end(), b, std::next(b.begin()));
+    EXPECT_EQ(to_vector(a), (std::vector<int>{0, 1, 2, 11}));
+    EXPECT_EQ(to_vector(b), (std::vector<int>{10, 12}));
+
+    a.splice(a.begin(), b, b.begin(), b.end());
+    EXPECT_EQ(to_vector(a), (std::vector<int>{10, 12, 0, 1, 2, 11}));
+    EXPECT_EQ(a.size(), 6);
+    EXPECT_EQ(b.size(), 0);
+
+    // Перестановка внутри одного списка не меняет размер
+    a.splice(a.begin(), a, std::next(a.begin(), 2), std::next(a.begin(), 5));
+    EXPECT_EQ(to_vector(a), (std::vector<int>{0, 1, 2, 10, 12, 11}));
+    a.splice(a.end(), a, a.begin());
+    EXPECT_EQ(to_vector(a), (std::vector<int>{1, 2, 10, 12, 11, 0}));
+    a.splice(a.begin(), a, a.begin());
+    EXPECT_EQ(a.size(), 6);
+    EXPECT_EQ(*std::prev(a.end()), 0);
+}
+
+// Тест 23: splice между разными ресурсами запрещён
+TEST(DoublyLinkedListTest, SpliceDifferentResourceThrows) {
+    fixed_block_memory_resource mr1(1024);
+    fixed_block_memory_resource mr2(1024);
+    doubly_linked_list<int> a(&mr1);
+    doubly_linked_list<int> b(&mr2);
+    a.push_back(1);
+    b.push_back(2);
+
+    EXPECT_THROW(a.splice(a.end(), b), std::invalid_argument);
+    EXPECT_THROW(a.splice(a.end(), b, b.begin()), std::invalid_argument);
+    EXPECT_EQ(a.size(), 1);
+    EXPECT_EQ(b.size(), 1);
+}
+
+// Тест 24: sort упорядочивает список без выделений и устойчиво
+TEST(DoublyLinkedListTest, Sort) {
+    fixed_block_memory_resource mr(64 * 1024);
+    doubly_linked_list<std::pair<int, int>> list(&mr);
+    std::vector<std::pair<int, int>> expected;
+    for (int i = 0; i < 1000; ++i) {
+        std::pair<int, int> item{(i * 7919) % 37, i}; // Много равных ключей
+        list.push_back(item);
+        expected.push_back(item);
+    }
+    auto by_key = [](const auto& a, const auto& b) { return a.first < b.first; };
+    std::stable_sort(expected.begin(), expected.end(), by_key);
+
+    size_t used = mr.get_used_memory();
+    list.sort(by_key);
+    EXPECT_EQ(mr.get_used_memory(), used);
+    EXPECT_EQ(to_vector(list), expected);
+    EXPECT_EQ(list.size(), 1000);
+    // prev-указатели восстановлены: обход в обратную сторону тоже упорядочен
+    EXPECT_TRUE(std::equal(list.rbegin(), list.rend(), expected.rbegin()));
+
+    doubly_linked_list<int> small(&mr);
+    small.sort();
+    small.push_back(2);
+    small.sort();
+    small.push_back(1);
+    small.sort();
+    EXPECT_EQ(to_vector(small), (std::vector<int>{1, 2}));
+    EXPECT_EQ(*std::prev(small.end()), 2);
+}
+
+// Тест 25: merge, unique и reverse
+TEST(DoublyLinkedListTest, MergeUniqueReverse) {
+    fixed_block_memory_resource mr(4096);
+    doubly_linked_list<int> a(&mr);
+    doubly_linked_list<int> b(&mr);
+    for (int value : {1, 3, 3, 7}) {
+        a.push_back(value);
+    }
+    for (int value : {2, 3, 8, 9}) {
+        b.push_back(value);
+    }
+
+    a.merge(b);
+    EXPECT_EQ(to_vector(a), (std::vector<int>{1, 2, 3, 3, 3, 7, 8, 9}));
+    EXPECT_EQ(a.size(), 8);
+    EXPECT_TRUE(b.empty());
+
+    EXPECT_EQ(a.unique(), 2);
+    EXPECT_EQ(to_vector(a), (std::vector<int>{1, 2, 3, 7, 8, 9}));
+    EXPECT_EQ(a.size(), 6);
+
+    a.reverse();
+    EXPECT_EQ(to_vector(a), (std::vector<int>{9, 8, 7, 3, 2, 1}));
+    EXPECT_EQ(*std::prev(a.end()), 1);
+    EXPECT_EQ(*a.rbegin(), 1);
+
+    // Слияние по убыванию в пустой список
+    doubly_linked_list<int> c(&mr);
+    c.merge(a, std::greater<>());
+    EXPECT_EQ(to_vector(c), (std::vector<int>{9, 8, 7, 3, 2, 1}));
+
+    fixed_block_memory_resource other_mr(1024);
+    doubly_linked_list<int> d(&other_mr);
+    d.push_back(0);
+    EXPECT_THROW(c.merge(d), std::invalid_argument);
+}
+
+// Тест 26: Исключение из компаратора не теряет элементы
+TEST(DoublyLinkedListTest, SortExceptionSafety) {
+    fixed_block_memory_resource mr(4096);
+    doubly_linked_list<int> list(&mr);
+    for (int i = 0; i < 50; ++i) {
+        list.push_back(50 - i);
+    }
+    int calls = 0;
+    auto throwing = [&calls](int a, int b) {
+        if (++calls == 100) {
+            throw std::runtime_error("comparison failed");
+        }
+        return a < b;
+    };
+
+    EXPECT_THROW(list.sort(throwing), std::runtime_error);
+    EXPECT_EQ(list.size(), 50);
+    auto values = to_vector(list);
+    std::sort(values.begin(), values.end());
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_EQ(values[i], i + 1);
+    }
+    EXPECT_EQ(std::distance(list.rbegin(), list.rend()), 50);
+}
+
+// Тест 27: Конструкторы из диапазона, insert диапазона, append_range, assign
+TEST(DoublyLinkedListTest, RangeOperations) {
+    fixed_block_memory_resource mr(8192);
+    std::vector<int> source{1, 2, 3, 4};
+    doubly_linked_list<int> list(source.begin(), source.end(), &mr);
+    EXPECT_EQ(to_vector(list), source);
+    EXPECT_EQ(list.size(), 4);
+
+    doubly_linked_list<int> init({5, 6}, &mr);
+    EXPECT_EQ(to_vector(init), (std::vector<int>{5, 6}));
+
+    auto it = list.insert(std::next(list.begin()), {10, 11});
+    EXPECT_EQ(*it, 10);
+    EXPECT_EQ(to_vector(list), (std::vector<int>{1, 10, 11, 2, 3, 4}));
+    std::vector<int> empty;
+    EXPECT_EQ(list.insert(list.begin(), empty.begin(), empty.end()), list.begin());
+
+    list.append_range(std::vector<int>{7, 8});
+    list.append_range(std::views::iota(20, 22));
+    EXPECT_EQ(to_vector(list), (std::vector<int>{1, 10, 11, 2, 3, 4, 7, 8, 20, 21}));
+    EXPECT_EQ(*std::prev(list.end()), 21);
+
+    // assign короче и длиннее текущего содержимого
+    list.assign({9, 9, 9});
+    EXPECT_EQ(to_vector(list), (std::vector<int>{9, 9, 9}));
+    EXPECT_EQ(*std::prev(list.end()), 9);
+    list.assign(source.begin(), source.end());
+    list.assign({0, 1, 2, 3, 4, 5});
+    EXPECT_EQ(to_vector(list), (std::vector<int>{0, 1, 2, 3, 4, 5}));
+    EXPECT_EQ(list.size(), 6);
+
+    // Однопроходный диапазон: размер заранее неизвестен
+    std::istringstream input("30 31 32");
+    list.insert(list.end(), std::istream_iterator<int>(input), std::istream_iterator<int>());
+    EXPECT_EQ(list.size(), 9);
+    EXPECT_EQ(*std::prev(list.end()), 32);
+}
+
+// Тест 28: Узлы диапазона выделяются одним участком пула
+TEST(DoublyLinkedListTest, RangeBatchAllocation) {
+    fixed_block_memory_resource mr(64 * 1024);
+    std::vector<int> source(100);
+    std::iota(source.begin(), source.end(), 0);
+    doubly_linked_list<int> list(source.begin(), source.end(), &mr);
+
+    // Элементы лежат в памяти подряд с постоянным шагом
+    const char* first = reinterpret_cast<const char*>(&*list.begin());
+    ptrdiff_t stride = reinterpret_cast<const char*>(&*std::next(list.begin())) - first;
+    EXPECT_GT(stride, 0);
+    ptrdiff_t offset = 0;
+    for (const int& value : list) {
+        EXPECT_EQ(reinterpret_cast<const char*>(&value) - first, offset);
+        offset += stride;
+    }
+#if defined(FIXED_BLOCK_STATS)
+    EXPECT_EQ(mr.get_statistics().allocations, 100);
+    EXPECT_EQ(mr.get_statistics().search_length_histogram[0], 100);
+#endif
+
+    // Узлы освобождаются по одному
+    list.erase(std::next(list.begin(), 10), std::next(list.begin(), 20));
+    list.clear();
+    EXPECT_EQ(mr.get_fragmentation(), 0.0);
+
+    // Без fixed_block_memory_resource узлы выделяются по одному
+    std::pmr::monotonic_buffer_resource monotonic;
+    doubly_linked_list<int> other(source.begin(), source.end(), &monotonic);
+    EXPECT_EQ(to_vector(other), source);
+}
+
+// Тип, копирование которого бросает на заданном значении
+struct ThrowOnCopy {
+    int value;
+    ThrowOnCopy(int v) : value(v) {}
+    ThrowOnCopy(const ThrowOnCopy& other) : value(other.value) {
+        if (value == 13) {
+            throw std::runtime_error("copy failed");
+        }
+    }
+};
+
+// Тест 29: Исключение при вставке диапазона не меняет список и пул
+TEST(DoublyLinkedListTest, RangeInsertExceptionSafety) {
+    fixed_block_memory_resource mr(64 * 1024);
+    doubly_linked_list<ThrowOnCopy> list(&mr);
+    list.emplace_back(1);
+    size_t used = mr.get_used_memory();
+
+    std::vector<ThrowOnCopy> source;
+    source.reserve(10);
+    for (int i = 10; i < 20; ++i) {
+        source.emplace_back(i);
+    }
+    EXPECT_THROW(list.insert(list.end(), source.begin(), source.end()), std::runtime_error);
+    EXPECT_EQ(list.size(), 1);
+    EXPECT_EQ(list.begin()->value, 1);
+    EXPECT_EQ(std::next(list.begin()), list.end());
+    // Весь участок вернулся и снова доступен
+    list.emplace_back(2);
+    EXPECT_GE(mr.get_used_memory(), used);
+    list.pop_back();
+    list.clear();
+    EXPECT_EQ(mr.get_fragmentation(), 0.0);
+
+    EXPECT_THROW(doubly_linked_list<ThrowOnCopy>(source.begin(), source.end(), &mr), std::runtime_error);
+    EXPECT_EQ(mr.get_fragmentation(), 0.0);
+}
+
+// Тест 30: Копирование создаёт независимый список
+TEST(DoublyLinkedListTest, CopyConstructAssign) {
+    fixed_block_memory_resource mr(8192);
+    doubly_linked_list<int> original({1, 2, 3}, &mr);
+
+    // Без явного аллокатора копия берёт ресурс по умолчанию
+    doubly_linked_list<int> copy(original);
+    EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+    EXPECT_EQ(to_vector(copy), (std::vector<int>{1, 2, 3}));
+    *copy.begin() = 100;
+    EXPECT_EQ(*original.begin(), 1);
+
+    doubly_linked_list<int> pooled(original, &mr);
+    EXPECT_EQ(pooled.get_allocator().resource(), &mr);
+    EXPECT_EQ(to_vector(pooled), (std::vector<int>{1, 2, 3}));
+
+    // Присваивание сохраняет ресурс приёмника
+    fixed_block_memory_resource other_mr(8192);
+    doubly_linked_list<int> target({7, 7, 7, 7, 7}, &other_mr);
+    target = copy;
+    EXPECT_EQ(target.get_allocator().resource(), &other_mr);
+    EXPECT_EQ(to_vector(target), (std::vector<int>{100, 2, 3}));
+    target = target;
+    EXPECT_EQ(target.size(), 3);
+}
+
+// Тест 31: Перемещение за O(1) и поэлементное при разных ресурсах
+TEST(DoublyLinkedListTest, MoveConstructAssign) {
+    fixed_block_memory_resource mr(8192);
+    doubly_linked_list<CopyCounter> original(&mr);
+    for (int i = 0; i < 3; ++i) {
+        original.emplace_back(i);
+    }
+    const CopyCounter* first = &*original.begin();
+    CopyCounter::reset();
+
+    doubly_linked_list<CopyCounter> moved(std::move(original));
+    EXPECT_EQ(&*moved.begin(), first); // Узлы те же
+    EXPECT_TRUE(original.empty());
+    EXPECT_EQ(moved.size(), 3);
+    EXPECT_EQ(moved.get_allocator().resource(), &mr);
+
+    doubly_linked_list<CopyCounter> same(&mr);
+    same.emplace_back(42);
+    same = std::move(moved);
+    EXPECT_EQ(&*same.begin(), first);
+    EXPECT_TRUE(moved.empty());
+    EXPECT_EQ(CopyCounter::moves, 0);
+    EXPECT_EQ(CopyCounter::copies, 0);
+
+    // Разные ресурсы: элементы перемещаются по одному в свой ресурс
+    fixed_block_memory_resource other_mr(8192);
+    doubly_linked_list<CopyCounter> other(std::move(same), &other_mr);
+    EXPECT_EQ(CopyCounter::moves, 3);
+    EXPECT_EQ(CopyCounter::copies, 0);
+    EXPECT_EQ(other.size(), 3);
+    EXPECT_TRUE(other_mr.owns(&*other.begin()));
+
+    doubly_linked_list<CopyCounter> target(&mr);
+    target = std::move(other);
+    EXPECT_EQ(CopyCounter::moves, 6);
+    EXPECT_EQ(target.size(), 3);
+    EXPECT_TRUE(other.empty());
+    EXPECT_TRUE(mr.owns(&*target.begin()));
+    EXPECT_EQ(std::prev(target.end())->value, 2);
+}
+
+// Тест 32: swap обменивает содержимое без выделений
+TEST(DoublyLinkedListTest, Swap) {
+    fixed_block_memory_resource mr(8192);
+    doubly_linked_list<int> a({1, 2}, &mr);
+    doubly_linked_list<int> b({3}, &mr);
+
+    swap(a, b);
+    EXPECT_EQ(to_vector(a), (std::vector<int>{3}));
+    EXPECT_EQ(to_vector(b), (std::vector<int>{1, 2}));
+    EXPECT_EQ(*std::prev(b.end()), 2);
+
+    fixed_block_memory_resource other_mr(1024);
+    doubly_linked_list<int> c(&other_mr);
+    EXPECT_THROW(a.swap(c), std::invalid_argument);
+}
+
+// Тест 33: parallel_for_each обрабатывает каждый элемент ровно один раз
+TEST(DoublyLinkedListTest, ParallelForEach) {
+    fixed_block_memory_resource mr(1024 * 1024);
+    std::vector<int> source(10000);
+    std::iota(source.begin(), source.end(), 0);
+    doubly_linked_list<int> list(source.begin(), source.end(), &mr);
+
+    list.parallel_for_each([](int& value) { value *= 2; }, 4, 97);
+    int expected = 0;
+    for (int value : list) {
+        EXPECT_EQ(value, expected);
+        expected += 2;
+    }
+
+    // Один поток и кусок больше списка
+    list.parallel_for_each([](int& value) { value /= 2; }, 1, 100000);
+    EXPECT_EQ(to_vector(list), source);
+
+    doubly_linked_list<int> empty(&mr);
+    empty.parallel_for_each([](int&) { FAIL(); });
+}
+
+// Тест 34: parallel_reduce совпадает с последовательной свёрткой
+TEST(DoublyLinkedListTest, ParallelReduce) {
+    fixed_block_memory_resource mr(1024 * 1024);
+    std::vector<int> source(5000);
+    std::iota(source.begin(), source.end(), 1);
+    doubly_linked_list<int> list(source.begin(), source.end(), &mr);
+
+    EXPECT_EQ(list.parallel_reduce(0LL, std::plus<>(), 8, 64), 5000LL * 5001 / 2);
+    EXPECT_EQ(list.parallel_transform_reduce(0LL, std::plus<>(), [](int x) { return 1LL * x * x; }, 3, 100),
+              std::accumulate(source.begin(), source.end(), 0LL, [](long long acc, int x) { return acc + 1LL * x * x; }));
+
+    // Некоммутативная операция: куски объединяются по порядку
+    doubly_linked_list<std::string> words(&mr);
+    std::string expected;
+    for (int i = 0; i < 300; ++i) {
+        words.push_back(std::to_string(i % 10));
+        expected += std::to_string(i % 10);
+    }
+    EXPECT_EQ(words.parallel_reduce(std::string(), std::plus<>(), 4, 7), expected);
+
+    // Точки разбиения перестраиваются после изменения списка
+    EXPECT_EQ(list.parallel_reduce(0LL, std::plus<>(), 2, 50), 5000LL * 5001 / 2);
+    list.erase(list.begin(), std::next(list.begin(), 100));
+    list.push_back(1000000);
+    list.reverse();
+    EXPECT_EQ(list.parallel_reduce(0LL, std::plus<>(), 2, 50), 5000LL * 5001 / 2 - 100 * 101 / 2 + 1000000);
+    EXPECT_EQ(list.parallel_reduce(0, [](int a, int b) { return std::max(a, b); }, 2, 50), 1000000);
+}
+
+// Тест 35: Исключение из функции обхода пробрасывается вызывающему
+TEST(DoublyLinkedListTest, ParallelForEachException) {
+    fixed_block_memory_resource mr(256 * 1024);
+    std::vector<int> source(2000, 1);
+    source[1234] = -1;
+    doubly_linked_list<int> list(source.begin(), source.end(), &mr);
+
+    EXPECT_THROW(list.parallel_for_each([](int value) {
+        if (value < 0) {
+            throw std::runtime_error("negative value");
+        }
+    }, 4, 10), std::runtime_error);
+    // Список остаётся рабочим
+    EXPECT_EQ(list.parallel_reduce(0, std::plus<>(), 4, 10), 1999 - 1);
+}
+
+// Тест 36: for_each_prefetched обходит элементы по порядку при любом числе курсоров
+TEST(DoublyLinkedListTest, ForEachPrefetched) {
+    fixed_block_memory_resource mr(64 * 1024);
+    doubly_linked_list<int> list(&mr);
+    // Несколько кусков по PREFETCH_CHUNK узлов и неполный последний кусок
+    const int count = static_cast<int>(5 * doubly_linked_list<int>::PREFETCH_CHUNK + 7);
+    for (int i = 0; i < count; ++i) {
+        list.push_back((i * 37) % count);
+    }
+    list.sort(); // Порядок обхода больше не совпадает с порядком в памяти
+
+    for (size_t streams : {0, 1, 2, 3, 8, 1000}) {
+        std::vector<int> visited;
+        list.for_each_prefetched([&visited](int value) { visited.push_back(value); }, streams);
+        EXPECT_EQ(visited, to_vector(list));
+    }
+
+    list.for_each_prefetched([](int& value) { value += 1; });
+    const auto& view = list;
+    long long sum = 0;
+    view.for_each_prefetched([&sum](const int& value) { sum += value; });
+    EXPECT_EQ(sum, static_cast<long long>(count) * (count + 1) / 2);
+
+    // Точки разбиения перестраиваются после изменения списка
+    list.push_front(0);
+    list.erase(std::next(list.begin(), 100));
+    std::vector<int> visited;
+    list.for_each_prefetched([&visited](int value) { visited.push_back(value); });
+    EXPECT_EQ(visited, to_vector(list));
+
+    doubly_linked_list<int> empty(&mr);
+    empty.for_each_prefetched([](int) { FAIL(); });
+}
+
+// Тест 37: splice последнего узла другого списка в end()
+TEST(DoublyLinkedListTest, SpliceLastElementToEnd) {
+    fixed_block_memory_resource mr(4096);
+    doubly_linked_list<int> a(&mr);
+    doubly_linked_list<int> b(&mr);
+    a.push_back(1);
+    b.push_back(10);
+    b.push_back(11);
+
+    a.splice(a.end(), b, std::prev(b.end()));
+    EXPECT_EQ(to_vector(a), (std::vector<int>{1, 11}));
+    EXPECT_EQ(to_vector(b), (std::vector<int>{10}));
+    EXPECT_EQ(a.size(), 2);
+    EXPECT_EQ(b.size(), 1);
+
+    // Единственный узел в пустой список
+    doubly_linked_list<int> c(&mr);
+    c.splice(c.end(), b, b.begin());
+    EXPECT_EQ(to_vector(c), (std::vector<int>{10}));
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(*std::prev(c.end()), 10);
+}
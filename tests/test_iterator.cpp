@@ -4,6 +4,8 @@
 #include <iterator>
 #include <algorithm>
 #include <numeric>
+#include <ranges>
+#include <vector>
 
 // Тест 1: Типы итератора
 TEST(IteratorTest, TypeTraits) {
@@ -13,12 +15,16 @@ TEST(IteratorTest, TypeTraits) {
     using iterator = doubly_linked_list<int>::iterator;
     
     // Проверяем, что iterator_category правильный
-    bool is_forward = std::is_same<
+    bool is_bidirectional = std::is_same<
         typename std::iterator_traits<iterator>::iterator_category,
-        std::forward_iterator_tag
+        std::bidirectional_iterator_tag
     >::value;
     
-    EXPECT_TRUE(is_forward);
+    EXPECT_TRUE(is_bidirectional);
+    EXPECT_TRUE(std::bidirectional_iterator<iterator>);
+    EXPECT_TRUE(std::bidirectional_iterator<doubly_linked_list<int>::const_iterator>);
+    EXPECT_TRUE(std::ranges::bidirectional_range<doubly_linked_list<int>>);
+    EXPECT_TRUE(std::ranges::bidirectional_range<const doubly_linked_list<int>>);
 }
 
 // Тест 2: Разыменование
@@ -308,3 +314,87 @@ TEST(IteratorTest, MultipleIterators) {
     EXPECT_EQ(*it1, 2);
     EXPECT_EQ(*it2, 3); // it2 не изменился
 }
+
+// Тест 18: Шаг назад, в том числе из end()
+TEST(IteratorTest, Decrement) {
+    fixed_block_memory_resource mr(1024);
+    doubly_linked_list<int> list(&mr);
+
+    list.push_back(1);
+    list.push_back(2);
+    list.push_back(3);
+
+    auto it = list.end();
+    --it;
+    EXPECT_EQ(*it, 3);
+    EXPECT_EQ(*(it--), 3);
+    EXPECT_EQ(*it, 2);
+    --it;
+    EXPECT_EQ(it, list.begin());
+}
+
+// Тест 19: Обратный обход
+TEST(IteratorTest, ReverseIteration) {
+    fixed_block_memory_resource mr(1024);
+    doubly_linked_list<int> list(&mr);
+
+    for (int i = 1; i <= 5; ++i) {
+        list.push_back(i);
+    }
+
+    std::vector<int> reversed(list.rbegin(), list.rend());
+    EXPECT_EQ(reversed, (std::vector<int>{5, 4, 3, 2, 1}));
+
+    // Изменение через обратный итератор
+    *list.rbegin() = 50;
+    EXPECT_EQ(*std::prev(list.end()), 50);
+
+    doubly_linked_list<int> empty(&mr);
+    EXPECT_EQ(empty.rbegin(), empty.rend());
+}
+
+// Тест 20: Константные итераторы
+TEST(IteratorTest, ConstIterators) {
+    fixed_block_memory_resource mr(1024);
+    doubly_linked_list<int> list(&mr);
+
+    list.push_back(1);
+    list.push_back(2);
+
+    const auto& const_list = list;
+    int sum = 0;
+    for (int value : const_list) {
+        sum += value;
+    }
+    EXPECT_EQ(sum, 3);
+
+    doubly_linked_list<int>::const_iterator it = list.begin(); // iterator -> const_iterator
+    EXPECT_EQ(it, list.cbegin());
+    EXPECT_EQ(*list.crbegin(), 2);
+    EXPECT_TRUE((std::is_same_v<decltype(*it), const int&>));
+    EXPECT_EQ(std::distance(list.cbegin(), list.cend()), 2);
+}
+
+// Тест 21: Алгоритмы std::ranges
+TEST(IteratorTest, RangesAlgorithms) {
+    fixed_block_memory_resource mr(1024);
+    doubly_linked_list<int> list(&mr);
+
+    for (int i = 1; i <= 6; ++i) {
+        list.push_back(i);
+    }
+
+    auto found = std::ranges::find(list, 4);
+    ASSERT_NE(found, list.end());
+    EXPECT_EQ(*found, 4);
+
+    std::vector<int> evens_reversed;
+    for (int value : list | std::views::reverse | std::views::filter([](int v) { return v % 2 == 0; })) {
+        evens_reversed.push_back(value);
+    }
+    EXPECT_EQ(evens_reversed, (std::vector<int>{6, 4, 2}));
+
+    std::ranges::reverse(list);
+    EXPECT_EQ(*list.begin(), 6);
+    EXPECT_EQ(*std::prev(list.end()), 1);
+}
@@ -1,6 +1,45 @@
 #include <gtest/gtest.h>
 #include "../include/fixed_block_memory_resource.h"
+#include "../include/synchronized_fixed_block_memory_resource.h"
+#include "../include/doubly_linked_list.h"
 #include <memory_resource>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <system_error>
+#include <unistd.h>
+
+// Счётчик обращений к глобальной куче для проверки режима in_pool
+namespace {
+    std::atomic<size_t> global_allocations{0};
+    std::atomic<size_t> global_deallocations{0};
+}
+
+void* operator new(size_t size) {
+    ++global_allocations;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    if (ptr) {
+        ++global_deallocations;
+    }
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    if (ptr) {
+        ++global_deallocations;
+    }
+    std::free(ptr);
+}
 
 // Тест 1: Создание memory_resource
 TEST(MemoryResourceTest, Construction) {
@@ -130,3 +169,848 @@ TEST(MemoryResourceTest, DifferentSizes) {
     EXPECT_NE(ptr_medium, ptr_large);
     EXPECT_NE(ptr_small, ptr_large);
 }
+
+
+// Тест 11: Переиспользование идёт по классу размеров (размер, выравнивание)
+TEST(MemoryResourceTest, SizeClassReuse) {
+    fixed_block_memory_resource mr(4096);
+
+    void* small = mr.allocate(16, alignof(int));
+    void* guard = mr.allocate(16, alignof(int)); // Не даёт блокам слиться
+    void* large = mr.allocate(256, alignof(int));
+    EXPECT_NE(guard, nullptr);
+    mr.deallocate(small, 16, alignof(int));
+    mr.deallocate(large, 256, alignof(int));
+
+    // Каждый запрос получает блок своего класса
+    EXPECT_EQ(mr.allocate(256, alignof(int)), large);
+    EXPECT_EQ(mr.allocate(16, alignof(int)), small);
+}
+
+// Тест 12: Повторное выделение не растит пул при большом количестве блоков
+TEST(MemoryResourceTest, ReuseManyBlocks) {
+    fixed_block_memory_resource mr(64 * 1024);
+
+    std::vector<void*> pointers;
+    for (int i = 0; i < 1000; ++i) {
+        pointers.push_back(mr.allocate(24, alignof(void*)));
+    }
+    size_t used = mr.get_used_memory();
+
+    for (void* ptr : pointers) {
+        mr.deallocate(ptr, 24, alignof(void*));
+    }
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_NE(mr.allocate(24, alignof(void*)), nullptr);
+    }
+    EXPECT_EQ(mr.get_used_memory(), used);
+}
+
+// Тест 13: Повторное освобождение блока
+TEST(MemoryResourceTest, DoubleDeallocate) {
+    fixed_block_memory_resource mr(1024);
+
+    void* ptr = mr.allocate(64, alignof(int));
+    mr.deallocate(ptr, 64, alignof(int));
+
+    EXPECT_THROW({
+        mr.deallocate(ptr, 64, alignof(int));
+    }, std::invalid_argument);
+}
+
+// Тест 14: Указатель внутрь выделенного блока не считается блоком ресурса
+TEST(MemoryResourceTest, InteriorPointerDeallocate) {
+    fixed_block_memory_resource mr(1024);
+
+    char* ptr = static_cast<char*>(mr.allocate(64, alignof(int)));
+
+    EXPECT_THROW({
+        mr.deallocate(ptr + 8, 56, alignof(int));
+    }, std::invalid_argument);
+    EXPECT_NO_THROW({
+        mr.deallocate(ptr, 64, alignof(int));
+    });
+}
+
+// Тест 15: Большой свободный блок делится под маленький запрос
+TEST(MemoryResourceTest, BlockSplitting) {
+    fixed_block_memory_resource mr(4096);
+
+    char* large = static_cast<char*>(mr.allocate(256, alignof(int)));
+    void* guard = mr.allocate(16, alignof(int));
+    EXPECT_NE(guard, nullptr);
+    mr.deallocate(large, 256, alignof(int));
+    size_t used = mr.get_used_memory();
+
+    // Оба запроса помещаются в освобождённый блок
+    char* first = static_cast<char*>(mr.allocate(16, alignof(int)));
+    char* second = static_cast<char*>(mr.allocate(16, alignof(int)));
+    EXPECT_EQ(first, large);
+    EXPECT_GE(second, large + 16);
+    EXPECT_LT(second, large + 256);
+    EXPECT_EQ(mr.get_used_memory(), used);
+}
+
+// Тест 16: Соседние свободные блоки сливаются
+TEST(MemoryResourceTest, BlockCoalescing) {
+    fixed_block_memory_resource mr(4096);
+
+    void* a = mr.allocate(64, alignof(int));
+    void* b = mr.allocate(64, alignof(int));
+    void* c = mr.allocate(64, alignof(int));
+    void* guard = mr.allocate(16, alignof(int));
+    EXPECT_NE(guard, nullptr);
+    size_t used = mr.get_used_memory();
+
+    // Освобождаем в порядке, при котором срабатывает слияние с обеих сторон
+    mr.deallocate(a, 64, alignof(int));
+    mr.deallocate(c, 64, alignof(int));
+    mr.deallocate(b, 64, alignof(int));
+
+    // Запрос на 192 байта помещается в объединённый блок
+    EXPECT_EQ(mr.allocate(192, alignof(int)), a);
+    EXPECT_EQ(mr.get_used_memory(), used);
+}
+
+// Тест 17: Выравнивание сильнее гранулы внутри свободного блока
+TEST(MemoryResourceTest, OverAlignedReuse) {
+    fixed_block_memory_resource mr(4096);
+
+    void* large = mr.allocate(512, alignof(int));
+    void* guard = mr.allocate(16, alignof(int));
+    EXPECT_NE(guard, nullptr);
+    mr.deallocate(large, 512, alignof(int));
+
+    void* aligned = mr.allocate(64, 128);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned) % 128, 0);
+    EXPECT_GE(aligned, large);
+    EXPECT_LT(static_cast<char*>(aligned), static_cast<char*>(large) + 512);
+    mr.deallocate(aligned, 64, 128);
+
+    // После освобождения блок снова цельный
+    EXPECT_EQ(mr.allocate(512, alignof(int)), large);
+}
+
+// Тест 18: Смешанные размеры не исчерпывают пул раньше времени
+TEST(MemoryResourceTest, MixedSizesDoNotFragment) {
+    fixed_block_memory_resource mr(8192);
+
+    for (int round = 0; round < 100; ++round) {
+        std::vector<void*> small;
+        for (int i = 0; i < 16; ++i) {
+            small.push_back(mr.allocate(24, alignof(void*)));
+        }
+        for (void* ptr : small) {
+            mr.deallocate(ptr, 24, alignof(void*));
+        }
+        void* large = nullptr;
+        EXPECT_NO_THROW({
+            large = mr.allocate(48 + round, alignof(void*));
+        });
+        mr.deallocate(large, 48 + round, alignof(void*));
+    }
+    EXPECT_LE(mr.get_used_memory(), 1024);
+}
+
+// Тест 19: Коэффициент фрагментации
+TEST(MemoryResourceTest, Fragmentation) {
+    fixed_block_memory_resource mr(1024);
+    EXPECT_DOUBLE_EQ(mr.get_fragmentation(), 0.0);
+
+    std::vector<void*> pointers;
+    for (int i = 0; i < 8; ++i) {
+        pointers.push_back(mr.allocate(64, alignof(int)));
+    }
+    // Освобождаем каждый второй блок: свободные участки разрознены
+    for (size_t i = 0; i < pointers.size(); i += 2) {
+        mr.deallocate(pointers[i], 64, alignof(int));
+    }
+    EXPECT_GT(mr.get_fragmentation(), 0.0);
+
+    // После освобождения остальных блоков всё сливается в один участок
+    for (size_t i = 1; i < pointers.size(); i += 2) {
+        mr.deallocate(pointers[i], 64, alignof(int));
+    }
+    EXPECT_DOUBLE_EQ(mr.get_fragmentation(), 0.0);
+}
+
+// Тест 20: Синхронизированный ресурс - базовые операции
+TEST(SynchronizedMemoryResourceTest, BasicAllocation) {
+    synchronized_fixed_block_memory_resource mr(4096);
+
+    void* ptr = mr.allocate(64, alignof(int));
+    EXPECT_NE(ptr, nullptr);
+    mr.deallocate(ptr, 64, alignof(int));
+
+    // Блок берётся обратно из магазина потока
+    EXPECT_EQ(mr.allocate(64, alignof(int)), ptr);
+
+    void* fake_ptr = reinterpret_cast<void*>(0x12345678);
+    EXPECT_THROW({
+        mr.deallocate(fake_ptr, 64, alignof(int));
+    }, std::invalid_argument);
+}
+
+// Тест 21: Блоки из магазинов возвращаются в пул при нехватке памяти
+TEST(SynchronizedMemoryResourceTest, DrainCachesOnExhaustion) {
+    synchronized_fixed_block_memory_resource mr(4096);
+
+    std::vector<void*> pointers;
+    for (int i = 0; i < 32; ++i) {
+        pointers.push_back(mr.allocate(32, alignof(int)));
+    }
+    for (void* ptr : pointers) {
+        mr.deallocate(ptr, 32, alignof(int));
+    }
+
+    // Весь пул, кроме закэшированных блоков, занят крупным запросом
+    void* large = nullptr;
+    EXPECT_NO_THROW({
+        large = mr.allocate(3072, alignof(int));
+    });
+    EXPECT_NE(large, nullptr);
+}
+
+// Тест 22: Нагрузочный тест из нескольких потоков
+TEST(SynchronizedMemoryResourceTest, MultiThreadedStress) {
+    synchronized_fixed_block_memory_resource mr(8 * 1024 * 1024);
+    constexpr int THREADS = 8;
+    constexpr int ITERATIONS = 20000;
+
+    std::vector<std::thread> workers;
+    std::vector<int> errors(THREADS, 0);
+    for (int t = 0; t < THREADS; ++t) {
+        workers.emplace_back([&mr, &errors, t] {
+            std::vector<std::pair<unsigned char*, size_t>> live;
+            for (int i = 0; i < ITERATIONS; ++i) {
+                if (live.size() < 64 && (i % 3 != 2)) {
+                    size_t bytes = 16 + (i % 4) * 16;
+                    auto* ptr = static_cast<unsigned char*>(mr.allocate(bytes, alignof(std::max_align_t)));
+                    std::memset(ptr, t, bytes); // Метка владельца блока
+                    live.emplace_back(ptr, bytes);
+                } else if (!live.empty()) {
+                    auto [ptr, bytes] = live.back();
+                    live.pop_back();
+                    // Блок не должен был достаться другому потоку
+                    for (size_t k = 0; k < bytes; ++k) {
+                        if (ptr[k] != static_cast<unsigned char>(t)) {
+                            ++errors[t];
+                            break;
+                        }
+                    }
+                    mr.deallocate(ptr, bytes, alignof(std::max_align_t));
+                }
+            }
+            for (auto [ptr, bytes] : live) {
+                mr.deallocate(ptr, bytes, alignof(std::max_align_t));
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    for (int t = 0; t < THREADS; ++t) {
+        EXPECT_EQ(errors[t], 0);
+    }
+}
+
+// Тест 23: Списки в разных потоках над одним ресурсом
+TEST(SynchronizedMemoryResourceTest, ListsSharingResource) {
+    synchronized_fixed_block_memory_resource mr(4 * 1024 * 1024);
+    constexpr int THREADS = 4;
+
+    std::vector<long long> sums(THREADS, 0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < THREADS; ++t) {
+        workers.emplace_back([&mr, &sums, t] {
+            doubly_linked_list<int> list(&mr);
+            for (int round = 0; round < 10; ++round) {
+                for (int i = 0; i < 1000; ++i) {
+                    list.push_back(i);
+                }
+                while (list.size() > 500) {
+                    list.pop_front();
+                }
+            }
+            for (int value : list) {
+                sums[t] += value;
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    for (int t = 0; t < THREADS; ++t) {
+        EXPECT_EQ(sums[t], 500LL * (500 + 999) / 2);
+    }
+}
+
+// Тест 24: Метаданные в пуле - ни одного обращения к глобальной куче
+TEST(MemoryResourceTest, InPoolMetadataNoHeapAllocations) {
+    fixed_block_memory_resource::options opts;
+    opts.metadata = fixed_block_memory_resource::metadata_placement::in_pool;
+    fixed_block_memory_resource mr(256 * 1024, opts);
+
+    size_t before = global_allocations.load();
+    {
+        std::vector<void*> pointers;
+        pointers.reserve(512);
+        size_t before_loop = global_allocations.load();
+        for (int round = 0; round < 10; ++round) {
+            for (int i = 0; i < 512; ++i) {
+                pointers.push_back(mr.allocate(16 + (i % 3) * 16, alignof(int)));
+            }
+            for (int i = 0; i < 512; i += 2) {
+                mr.deallocate(pointers[i], 16 + (i % 3) * 16, alignof(int));
+            }
+            for (int i = 1; i < 512; i += 2) {
+                mr.deallocate(pointers[i], 16 + (i % 3) * 16, alignof(int));
+            }
+            pointers.clear();
+        }
+        EXPECT_EQ(global_allocations.load(), before_loop);
+    }
+
+    doubly_linked_list<int> list(&mr);
+    for (int i = 0; i < 500; ++i) {
+        list.push_back(i);
+        list.push_front(i);
+    }
+    while (!list.empty()) {
+        list.pop_back();
+    }
+    EXPECT_EQ(global_allocations.load(), before + 1); // Только reserve вектора
+}
+
+// Тест 25: Режим in_pool хранит заголовки в самих блоках
+TEST(MemoryResourceTest, InPoolBlockHeaders) {
+    fixed_block_memory_resource::options opts;
+    opts.metadata = fixed_block_memory_resource::metadata_placement::in_pool;
+    fixed_block_memory_resource mr(4096, opts);
+
+    // Весь пул под блоки, кроме барьера в конце
+    EXPECT_EQ(mr.get_free_memory(), 4096 - 16);
+    // 24 байта данных и 8 байт заголовка занимают 32 байта, как в режиме heap
+    char* a = static_cast<char*>(mr.allocate(24, alignof(int)));
+    char* b = static_cast<char*>(mr.allocate(24, alignof(int)));
+    EXPECT_EQ(b - a, 32);
+    EXPECT_EQ(mr.get_used_memory(), 64);
+    void* aligned = mr.allocate(64, 64);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned) % 64, 0);
+
+    mr.deallocate(a, 24, alignof(int));
+    EXPECT_THROW(mr.deallocate(a, 24, alignof(int)), std::invalid_argument);
+    EXPECT_THROW(mr.deallocate(b, 200, alignof(int)), std::invalid_argument);
+    EXPECT_THROW(mr.deallocate(b + 16, 24, alignof(int)), std::invalid_argument);
+    mr.deallocate(b, 24, alignof(int));
+    mr.deallocate(aligned, 64, 64);
+    // Свободные блоки слились с "хвостом"
+    EXPECT_EQ(mr.get_used_memory(), 0);
+    EXPECT_THROW(mr.deallocate(aligned, 64, 64), std::invalid_argument);
+    EXPECT_EQ(mr.allocate(24, alignof(int)), a);
+
+    // Шаг allocate_contiguous включает заголовок блока
+    EXPECT_EQ(mr.block_stride(24), 32);
+    char* run = static_cast<char*>(mr.allocate_contiguous(24, alignof(int), 4));
+    EXPECT_EQ(run - a, 32);
+    mr.deallocate(run + 32, 24, alignof(int));
+    EXPECT_THROW(mr.deallocate(run + 32, 24, alignof(int)), std::invalid_argument);
+    for (size_t i : {0, 2, 3}) {
+        mr.deallocate(run + i * 32, 24, alignof(int));
+    }
+    EXPECT_EQ(mr.get_used_memory(), 32);
+    mr.deallocate(a, 24, alignof(int));
+
+    EXPECT_THROW({
+        fixed_block_memory_resource too_small(32, opts);
+    }, std::invalid_argument);
+}
+
+// Тест 26: Растущий пул добавляет арены вместо bad_alloc
+TEST(MemoryResourceTest, GrowableArenas) {
+    fixed_block_memory_resource::options opts;
+    opts.growable = true;
+    fixed_block_memory_resource mr(1024, opts);
+
+    void* first = mr.allocate(512, alignof(int));
+    std::vector<void*> pointers;
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_NO_THROW({
+            pointers.push_back(mr.allocate(256, alignof(int)));
+        });
+    }
+
+    auto usage = mr.get_arena_usage();
+    ASSERT_GT(usage.size(), 1);
+    // Первая арена остаётся на месте, следующие растут геометрически
+    EXPECT_LE(usage[0].base, first);
+    EXPECT_EQ(usage[0].size, 1024);
+    EXPECT_EQ(usage[1].size, 2048);
+    for (void* ptr : pointers) {
+        EXPECT_TRUE(mr.owns(ptr));
+    }
+
+    size_t used = 0;
+    for (const auto& arena : usage) {
+        EXPECT_LE(arena.used, arena.size);
+        used += arena.used;
+    }
+    EXPECT_EQ(used, mr.get_used_memory());
+}
+
+// Тест 27: Предел роста и внешний источник памяти для арен
+TEST(MemoryResourceTest, GrowthCapAndUpstream) {
+    std::pmr::unsynchronized_pool_resource upstream;
+    fixed_block_memory_resource::options opts;
+    opts.growable = true;
+    opts.growth_factor = 1.0;
+    opts.max_total_size = 3072;
+    opts.upstream = &upstream;
+    fixed_block_memory_resource mr(1024, opts);
+
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_NO_THROW({
+            (void)mr.allocate(1024, alignof(int));
+        });
+    }
+    EXPECT_EQ(mr.get_arena_usage().size(), 3);
+    EXPECT_THROW({
+        (void)mr.allocate(64, alignof(int));
+    }, std::bad_alloc);
+}
+
+// Тест 28: Блоки из разных арен не сливаются
+TEST(MemoryResourceTest, NoCoalescingAcrossArenas) {
+    fixed_block_memory_resource::options opts;
+    opts.growable = true;
+    fixed_block_memory_resource mr(256, opts);
+
+    void* a = mr.allocate(256, alignof(int));
+    void* b = mr.allocate(256, alignof(int));
+    EXPECT_EQ(mr.get_arena_usage().size(), 2);
+    mr.deallocate(a, 256, alignof(int));
+    mr.deallocate(b, 256, alignof(int));
+
+    // Запрос на 512 байт не может занять память сразу двух арен
+    void* c = mr.allocate(512, alignof(int));
+    EXPECT_NE(c, a);
+    EXPECT_EQ(mr.allocate(256, alignof(int)), a);
+}
+
+// Тест 29: Пул на анонимном отображении mmap
+TEST(MemoryResourceTest, MmapBacking) {
+    fixed_block_memory_resource::options opts;
+    opts.backing = fixed_block_memory_resource::backing_store::mmap;
+    opts.pages = fixed_block_memory_resource::huge_pages::advise;
+    fixed_block_memory_resource mr(4 * 1024 * 1024, opts);
+
+    auto* ptr = static_cast<char*>(mr.allocate(4096, alignof(int)));
+    std::memset(ptr, 0x5a, 4096);
+    EXPECT_EQ(ptr[4095], 0x5a);
+    mr.deallocate(ptr, 4096, alignof(int));
+    EXPECT_EQ(mr.allocate(4096, alignof(int)), ptr);
+}
+
+// Тест 30: Большой пул создаётся без предварительного выделения страниц
+TEST(MemoryResourceTest, MmapLazyCommit) {
+    fixed_block_memory_resource::options opts;
+    opts.backing = fixed_block_memory_resource::backing_store::mmap;
+
+    auto start = std::chrono::steady_clock::now();
+    fixed_block_memory_resource mr(size_t{4} * 1024 * 1024 * 1024, opts);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_LT(elapsed, std::chrono::milliseconds(100));
+    EXPECT_NE(mr.allocate(64, alignof(int)), nullptr);
+}
+
+// Тест 31: Привязка к узлу NUMA и явные большие страницы
+TEST(MemoryResourceTest, MmapNumaAndHugeTlb) {
+    fixed_block_memory_resource::options opts;
+    opts.backing = fixed_block_memory_resource::backing_store::mmap;
+    opts.numa_node = 0;
+    try {
+        fixed_block_memory_resource mr(1024 * 1024, opts);
+        EXPECT_NE(mr.allocate(64, alignof(int)), nullptr);
+    } catch (const std::system_error&) {
+        // Ядро без поддержки NUMA
+    }
+
+    opts.numa_node = -1;
+    opts.pages = fixed_block_memory_resource::huge_pages::required;
+    try {
+        fixed_block_memory_resource mr(1024 * 1024, opts);
+        EXPECT_NE(mr.allocate(64, alignof(int)), nullptr);
+    } catch (const std::system_error&) {
+        // Большие страницы не зарезервированы в системе
+    }
+
+    // Без mmap эти параметры недоступны
+    opts.backing = fixed_block_memory_resource::backing_store::heap;
+    EXPECT_THROW({
+        fixed_block_memory_resource mr(1024, opts);
+    }, std::invalid_argument);
+}
+
+// Тест 32: release() освобождает все блоки разом
+TEST(MemoryResourceTest, Release) {
+    fixed_block_memory_resource mr(4096);
+
+    void* first = mr.allocate(64, alignof(int));
+    for (int i = 0; i < 10; ++i) {
+        (void)mr.allocate(32, alignof(int));
+    }
+    EXPECT_GT(mr.get_used_memory(), 0);
+
+    mr.release();
+    EXPECT_EQ(mr.get_used_memory(), 0);
+    EXPECT_EQ(mr.get_free_memory(), 4096);
+    // Старые указатели больше не принадлежат блокам
+    EXPECT_THROW({
+        mr.deallocate(first, 64, alignof(int));
+    }, std::invalid_argument);
+    EXPECT_EQ(mr.allocate(64, alignof(int)), first);
+}
+
+// Тест 33: release() в режимах in_pool и с ростом пула
+TEST(MemoryResourceTest, ReleaseInPoolAndGrowable) {
+    fixed_block_memory_resource::options opts;
+    opts.metadata = fixed_block_memory_resource::metadata_placement::in_pool;
+    opts.growable = true;
+    fixed_block_memory_resource mr(8 * 1024, opts);
+
+    for (int round = 0; round < 3; ++round) {
+        doubly_linked_list<int> list(&mr);
+        for (int i = 0; i < 500; ++i) {
+            list.push_back(i);
+        }
+        EXPECT_GT(mr.get_arena_usage().size(), 1);
+
+        // Список отказывается от узлов, ресурс освобождает их разом
+        list.discard();
+        EXPECT_TRUE(list.empty());
+        mr.release();
+        EXPECT_EQ(mr.get_arena_usage().size(), 1);
+        EXPECT_EQ(mr.get_used_memory(), 0);
+    }
+}
+
+// Тест 34: Статистика выделений
+TEST(MemoryResourceTest, Statistics) {
+    fixed_block_memory_resource mr(256);
+#if defined(FIXED_BLOCK_STATS)
+    auto stats = mr.get_statistics();
+    EXPECT_EQ(stats.allocations, 0);
+
+    void* a = mr.allocate(20, alignof(int)); // Округляется до 32 байт
+    void* b = mr.allocate(64, alignof(int));
+    mr.deallocate(a, 20, alignof(int));
+    void* c = mr.allocate(20, alignof(int)); // Из корзины свободных блоков
+    EXPECT_THROW({
+        (void)mr.allocate(1024, alignof(int));
+    }, std::bad_alloc);
+
+    stats = mr.get_statistics();
+    EXPECT_EQ(stats.allocations, 3);
+    EXPECT_EQ(stats.deallocations, 1);
+    EXPECT_EQ(stats.reused_allocations, 1);
+    EXPECT_EQ(stats.failed_allocations, 1);
+    EXPECT_DOUBLE_EQ(stats.reuse_hit_rate(), 1.0 / 3.0);
+    EXPECT_EQ(stats.live_bytes, 96);
+    EXPECT_EQ(stats.peak_live_bytes, 96);
+    EXPECT_EQ(stats.padding_bytes, 12);
+    EXPECT_EQ(stats.search_length_histogram[0], 2);
+    EXPECT_EQ(stats.search_length_histogram[1], 1);
+
+    std::string json = stats.to_json();
+    EXPECT_NE(json.find("\"allocations\":3"), std::string::npos);
+    EXPECT_NE(json.find("\"search_length_histogram\":[2,1,0,0,0,0]"), std::string::npos);
+
+    mr.deallocate(b, 64, alignof(int));
+    mr.deallocate(c, 20, alignof(int));
+    EXPECT_EQ(mr.get_statistics().live_bytes, 0);
+    EXPECT_EQ(mr.get_statistics().padding_bytes, 0);
+#else
+    // Без FIXED_BLOCK_STATS счётчики не ведутся
+    (void)mr.allocate(64, alignof(int));
+    EXPECT_EQ(mr.get_statistics().allocations, 0);
+#endif
+}
+
+// Тест 35: allocate_contiguous выдаёт блоки подряд, каждый освобождается отдельно
+TEST(MemoryResourceTest, AllocateContiguous) {
+    fixed_block_memory_resource mr(4096);
+    void* guard = mr.allocate(16, alignof(int));
+    size_t stride = mr.block_stride(24);
+    EXPECT_EQ(stride, 32);
+
+    char* base = static_cast<char*>(mr.allocate_contiguous(24, alignof(int), 10));
+    ASSERT_NE(base, nullptr);
+    EXPECT_EQ(mr.get_used_memory(), 16 + 10 * stride);
+    for (size_t i = 0; i < 10; ++i) {
+        EXPECT_TRUE(mr.owns(base + i * stride));
+    }
+    // Блок из середины переиспользуется обычным allocate
+    mr.deallocate(base + 3 * stride, 24, alignof(int));
+    EXPECT_EQ(mr.allocate(24, alignof(int)), base + 3 * stride);
+    EXPECT_THROW(mr.deallocate(base + 1, 24, alignof(int)), std::invalid_argument);
+
+    for (size_t i = 0; i < 10; ++i) {
+        mr.deallocate(base + i * stride, 24, alignof(int));
+    }
+    mr.deallocate(guard, 16, alignof(int));
+    EXPECT_EQ(mr.get_fragmentation(), 0.0);
+    EXPECT_EQ(mr.allocate_contiguous(24, alignof(int), 0), nullptr);
+    EXPECT_THROW(mr.allocate_contiguous(64, 64, 2), std::invalid_argument);
+    // Участок не помещается в пул целиком
+    EXPECT_THROW(mr.allocate_contiguous(1024, alignof(int), 5), std::bad_alloc);
+
+#if defined(FIXED_BLOCK_STATS)
+    auto stats = mr.get_statistics();
+    EXPECT_EQ(stats.allocations, 12);
+    EXPECT_EQ(stats.deallocations, 12);
+    EXPECT_EQ(stats.live_bytes, 0);
+#endif
+}
+
+// Тест 36: Пул в файле открывается заново, блоки прошлого сеанса освобождаются по одному
+TEST(MemoryResourceTest, FileBackedPoolReopens) {
+    std::string path = (std::filesystem::temp_directory_path() /
+                        ("fixed_block_" + std::to_string(::getpid()) + ".pool")).string();
+    std::filesystem::remove(path);
+    fixed_block_memory_resource::options opts;
+    opts.backing = fixed_block_memory_resource::backing_store::file;
+    opts.file_path = path;
+
+    size_t offsets[3];
+    {
+        fixed_block_memory_resource mr(4096, opts);
+        char* base = static_cast<char*>(mr.get_arena_usage().front().base);
+        for (size_t i = 0; i < 3; ++i) {
+            char* p = static_cast<char*>(mr.allocate(32, alignof(int)));
+            std::memset(p, 'a' + static_cast<int>(i), 32);
+            offsets[i] = static_cast<size_t>(p - base);
+        }
+        mr.set_root(base + offsets[1]);
+        EXPECT_TRUE(mr.opened_cleanly());
+    }
+    // Заголовок файла с корзинами свободных блоков занимает целые кэш-линии
+    EXPECT_GT(std::filesystem::file_size(path), 4096);
+    EXPECT_EQ(std::filesystem::file_size(path) % 64, 0);
+
+    {
+        // Размер существующего файла важнее переданного
+        fixed_block_memory_resource mr(1024, opts);
+        EXPECT_TRUE(mr.opened_cleanly());
+        EXPECT_EQ(mr.get_arena_usage().front().size, 4096);
+        char* base = static_cast<char*>(mr.get_arena_usage().front().base);
+        EXPECT_EQ(mr.get_root(), base + offsets[1]);
+        // 32 байта данных и 8 байт заголовка каждого блока
+        EXPECT_EQ(mr.get_used_memory(), 3 * 48);
+        EXPECT_EQ(base[offsets[2]], 'c');
+
+        // Блок прошлого сеанса освобождается по своему заголовку и переиспользуется
+        mr.deallocate(base + offsets[1], 32, alignof(int));
+        EXPECT_THROW(mr.deallocate(base + offsets[1], 32, alignof(int)), std::invalid_argument);
+#if defined(FIXED_BLOCK_STATS)
+        EXPECT_EQ(mr.get_statistics().deallocations, 1);
+        EXPECT_EQ(mr.get_statistics().live_bytes, 2 * 48);
+#endif
+        EXPECT_EQ(mr.allocate(32, alignof(int)), base + offsets[1]);
+        EXPECT_THROW(mr.deallocate(base + offsets[0] + 8, 16, alignof(int)), std::invalid_argument);
+        int outside = 0;
+        EXPECT_THROW(mr.deallocate(&outside, sizeof(int), alignof(int)), std::invalid_argument);
+        for (size_t offset : offsets) {
+            mr.deallocate(base + offset, 32, alignof(int));
+        }
+        EXPECT_EQ(mr.get_fragmentation(), 0.0);
+        mr.flush();
+    }
+
+    // Файл другого формата и несовместимые режимы отвергаются
+    std::filesystem::resize_file(path, 32);
+    EXPECT_THROW(fixed_block_memory_resource(4096, opts), std::invalid_argument);
+    std::filesystem::remove(path);
+    opts.growable = true;
+    EXPECT_THROW(fixed_block_memory_resource(4096, opts), std::invalid_argument);
+    fixed_block_memory_resource heap_pool(4096);
+    EXPECT_THROW(heap_pool.set_root(nullptr), std::logic_error);
+    EXPECT_EQ(heap_pool.get_root(), nullptr);
+    EXPECT_FALSE(std::filesystem::exists(path));
+}
+
+// Тест 37: Арены, выданные upstream подряд, не сливаются в один свободный блок
+TEST(MemoryResourceTest, ContiguousUpstreamArenasDoNotMerge) {
+    alignas(std::max_align_t) static char buffer[8192];
+    std::pmr::monotonic_buffer_resource upstream(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    fixed_block_memory_resource::options opts;
+    opts.growable = true;
+    opts.growth_factor = 1.0;
+    opts.upstream = &upstream;
+    fixed_block_memory_resource mr(1024, opts);
+
+    void* first = mr.allocate(1024, alignof(int));
+    void* second = mr.allocate(1024, alignof(int));
+    void* third = mr.allocate(1024, alignof(int));
+    auto arenas = mr.get_arena_usage();
+    ASSERT_EQ(arenas.size(), 3);
+    // Предпосылка теста: вторая и третья арены лежат вплотную
+    ASSERT_EQ(static_cast<char*>(arenas[1].base) + arenas[1].size, arenas[2].base);
+
+    mr.deallocate(second, 1024, alignof(int));
+    mr.deallocate(third, 1024, alignof(int));
+    EXPECT_GT(mr.get_fragmentation(), 0.0);
+
+    // Блок на две арены обслуживается новой ареной, а не склеенными свободными
+    char* wide = static_cast<char*>(mr.allocate(2048, alignof(int)));
+    size_t containing = 0;
+    for (const auto& arena : mr.get_arena_usage()) {
+        char* base = static_cast<char*>(arena.base);
+        if (wide >= base && wide + 2048 <= base + arena.size) {
+            ++containing;
+        }
+    }
+    EXPECT_EQ(containing, 1);
+    EXPECT_EQ(mr.get_arena_usage().size(), 4);
+
+    // Свободные блоки разных арен по-прежнему выдаются по одному
+    void* reused_a = mr.allocate(1024, alignof(int));
+    void* reused_b = mr.allocate(1024, alignof(int));
+    EXPECT_TRUE((reused_a == second && reused_b == third) || (reused_a == third && reused_b == second));
+    mr.deallocate(first, 1024, alignof(int));
+}
+
+// Тест 38: Режим in_pool вмещает столько же узлов, сколько heap, и освобождает их без ошибок
+TEST(MemoryResourceTest, InPoolCapacityThenFree) {
+    using placement = fixed_block_memory_resource::metadata_placement;
+    size_t nodes[2] = {0, 0};
+    for (placement metadata : {placement::heap, placement::in_pool}) {
+        fixed_block_memory_resource::options opts;
+        opts.metadata = metadata;
+        fixed_block_memory_resource mr(1024 * 1024, opts);
+        doubly_linked_list<int> list(&mr);
+        EXPECT_THROW({
+            for (int i = 0;; ++i) {
+                list.push_back(i);
+            }
+        }, std::bad_alloc);
+        nodes[metadata == placement::in_pool] = list.size();
+
+        EXPECT_NO_THROW({
+            for (size_t i = 0; i < list.size() / 2; ++i) {
+                list.pop_back();
+                list.pop_front();
+            }
+            list.clear();
+        });
+        if (metadata == placement::in_pool) {
+            EXPECT_EQ(mr.get_used_memory(), 0);
+        }
+    }
+    // В режиме in_pool теряется только барьер в конце пула
+    EXPECT_GE(nodes[1] + 1, nodes[0]);
+    EXPECT_GT(nodes[1], 32000);
+
+    // Освобождение вперемешку после исчерпания пула
+    fixed_block_memory_resource::options opts;
+    opts.metadata = placement::in_pool;
+    fixed_block_memory_resource mr(64 * 1024, opts);
+    std::vector<void*> pointers;
+    EXPECT_THROW({
+        for (;;) {
+            pointers.push_back(mr.allocate(24, alignof(int)));
+        }
+    }, std::bad_alloc);
+    EXPECT_EQ(pointers.size(), (64 * 1024 - 16) / 32);
+    EXPECT_NO_THROW({
+        for (size_t i = 0; i < pointers.size(); i += 2) {
+            mr.deallocate(pointers[i], 24, alignof(int));
+        }
+        for (size_t i = 1; i < pointers.size(); i += 2) {
+            mr.deallocate(pointers[i], 24, alignof(int));
+        }
+    });
+    EXPECT_EQ(mr.get_fragmentation(), 0.0);
+    void* ptr = mr.allocate(24, alignof(int));
+    EXPECT_TRUE(mr.owns(ptr));
+    mr.deallocate(ptr, 24, alignof(int));
+}
+
+// Тест 39: Повторное и чужое освобождение отвергаются уже при попадании в магазин
+TEST(SynchronizedMemoryResourceTest, DoubleFreeRejectedByMagazine) {
+    synchronized_fixed_block_memory_resource mr(4096);
+
+    void* ptr = mr.allocate(64, alignof(int));
+    mr.deallocate(ptr, 64, alignof(int));
+    EXPECT_THROW({
+        mr.deallocate(ptr, 64, alignof(int));
+    }, std::invalid_argument);
+
+    // Блок лежит в магазине один раз и выдаётся один раз
+    void* first = mr.allocate(64, alignof(int));
+    void* second = mr.allocate(64, alignof(int));
+    EXPECT_EQ(first, ptr);
+    EXPECT_NE(second, ptr);
+
+    // Адрес внутри пула, но не начало блока
+    EXPECT_THROW({
+        mr.deallocate(static_cast<char*>(first) + 8, 32, alignof(int));
+    }, std::invalid_argument);
+    mr.deallocate(first, 64, alignof(int));
+    mr.deallocate(second, 64, alignof(int));
+}
+
+// Тест 40: Магазины принадлежат потокам: повторное освобождение из другого
+// потока отвергается, а блоки завершившегося потока возвращаются в пул
+TEST(SynchronizedMemoryResourceTest, ThreadLocalMagazines) {
+    synchronized_fixed_block_memory_resource mr(4096);
+
+    void* shared = mr.allocate(64, alignof(int));
+    std::thread([&mr, shared] {
+        mr.deallocate(shared, 64, alignof(int)); // Блок в магазине этого потока
+    }).join();
+    EXPECT_THROW(mr.deallocate(shared, 64, alignof(int)), std::invalid_argument);
+
+    std::thread([&mr] {
+        std::vector<void*> pointers;
+        for (int i = 0; i < 32; ++i) {
+            pointers.push_back(mr.allocate(32, alignof(int)));
+        }
+        for (void* ptr : pointers) {
+            mr.deallocate(ptr, 32, alignof(int));
+        }
+    }).join();
+    // Потоки завершились, их магазины пусты: весь пул снова доступен
+    void* large = nullptr;
+    EXPECT_NO_THROW({
+        large = mr.allocate(4096, alignof(int));
+    });
+    EXPECT_NE(large, nullptr);
+    mr.deallocate(large, 4096, alignof(int));
+
+    // Блок, выданный заново, освобождается без ложной тревоги
+    void* again = mr.allocate(64, alignof(int));
+    mr.deallocate(again, 64, alignof(int));
+}
+
+// Тест 41: release() с метаданными в куче не освобождает их узлы по одному
+TEST(MemoryResourceTest, ReleaseHeapMetadataWithoutPerBlockWork) {
+    fixed_block_memory_resource mr(1024 * 1024);
+    constexpr int BLOCKS = 10000;
+    for (int i = 0; i < BLOCKS; ++i) {
+        (void)mr.allocate(32, alignof(int));
+    }
+
+    size_t before = global_deallocations.load();
+    mr.release();
+    // Память метаданных возвращается кусками пула ресурса, а не по узлу на блок
+    EXPECT_LT(global_deallocations.load() - before, BLOCKS / 100);
+    EXPECT_EQ(mr.get_used_memory(), 0);
+
+    // После release ресурс снова выдаёт память с начала пула
+    void* first = mr.allocate(32, alignof(int));
+    EXPECT_EQ(first, mr.get_arena_usage().front().base);
+    mr.deallocate(first, 32, alignof(int));
+}
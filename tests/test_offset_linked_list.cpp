@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "../include/offset_linked_list.h"
+#include "../include/doubly_linked_list.h"
+#include "../include/fixed_block_memory_resource.h"
+#include <algorithm>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <vector>
+
+// Тест 1: Связи узла 32-битные, итераторы двунаправленные
+TEST(OffsetLinkedListTest, TypeTraits) {
+    using list_type = offset_linked_list<int>;
+    EXPECT_TRUE(std::bidirectional_iterator<list_type::iterator>);
+    EXPECT_TRUE(std::bidirectional_iterator<list_type::const_iterator>);
+    EXPECT_TRUE(std::ranges::bidirectional_range<list_type>);
+    EXPECT_TRUE(std::ranges::bidirectional_range<const list_type>);
+    EXPECT_EQ(sizeof(list_type::offset_type), 4);
+    EXPECT_EQ(list_type::node_size(), 2 * sizeof(std::uint32_t) + sizeof(int));
+}
+
+// Тест 2: push/pop с обоих концов и обход в обе стороны
+TEST(OffsetLinkedListTest, PushPopBothEnds) {
+    fixed_block_memory_resource mr(4096);
+    offset_linked_list<std::string> list(mr);
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.begin(), list.end());
+
+    list.push_back("b");
+    list.push_back("c");
+    list.push_front("a");
+    list.emplace_back(2, 'd');
+    EXPECT_EQ(list.size(), 4);
+    EXPECT_EQ(std::vector<std::string>(list.begin(), list.end()), (std::vector<std::string>{"a", "b", "c", "dd"}));
+    EXPECT_EQ(std::vector<std::string>(list.rbegin(), list.rend()), (std::vector<std::string>{"dd", "c", "b", "a"}));
+    EXPECT_EQ(*std::prev(list.end()), "dd");
+
+    list.pop_front();
+    list.pop_back();
+    EXPECT_EQ(std::vector<std::string>(list.cbegin(), list.cend()), (std::vector<std::string>{"b", "c"}));
+    list.clear();
+    EXPECT_TRUE(list.empty());
+    EXPECT_THROW(list.pop_back(), std::out_of_range);
+    EXPECT_THROW(list.pop_front(), std::out_of_range);
+}
+
+// Тест 3: Узел int вдвое меньше узла doubly_linked_list<int>
+TEST(OffsetLinkedListTest, HalvesMemoryPerElement) {
+    const int count = 1000;
+    fixed_block_memory_resource offset_mr(1024 * 1024);
+    fixed_block_memory_resource pointer_mr(1024 * 1024);
+    offset_linked_list<int> offset_list(offset_mr);
+    doubly_linked_list<int> pointer_list(&pointer_mr);
+    size_t offset_before = offset_mr.get_used_memory();
+    size_t pointer_before = pointer_mr.get_used_memory();
+    for (int i = 0; i < count; ++i) {
+        offset_list.push_back(i);
+        pointer_list.push_back(i);
+    }
+    size_t offset_bytes = offset_mr.get_used_memory() - offset_before;
+    size_t pointer_bytes = pointer_mr.get_used_memory() - pointer_before;
+    EXPECT_EQ(offset_bytes * 2, pointer_bytes);
+    EXPECT_TRUE(std::equal(offset_list.begin(), offset_list.end(), pointer_list.begin(), pointer_list.end()));
+}
+
+// Тест 4: Блок вне области отвергается, список не меняется
+TEST(OffsetLinkedListTest, RejectsBlocksOutsideRegion) {
+    fixed_block_memory_resource::options opts;
+    opts.growable = true;
+    fixed_block_memory_resource mr(1024, opts);
+    offset_linked_list<int> list(mr);
+
+    int pushed = 0;
+    EXPECT_THROW({
+        for (;; ++pushed) {
+            list.push_back(pushed);
+        }
+    }, std::bad_alloc);
+    EXPECT_GT(pushed, 0);
+    EXPECT_EQ(list.size(), static_cast<size_t>(pushed));
+    EXPECT_GT(mr.get_arena_usage().size(), 1);
+    EXPECT_EQ(*std::prev(list.end()), pushed - 1);
+}
+
+// Тест 5: Область больше 4 ГиБ не адресуется 32-битными смещениями
+TEST(OffsetLinkedListTest, RejectsOversizedRegion) {
+    fixed_block_memory_resource mr(4096);
+    void* base = mr.get_arena_usage().front().base;
+    EXPECT_THROW(offset_linked_list<int>(&mr, base, size_t{1} << 33), std::invalid_argument);
+
+    offset_linked_list<int> list(&mr, base, mr.get_arena_usage().front().size);
+    list.push_back(1);
+    EXPECT_TRUE(mr.owns(static_cast<char*>(base) + list.control_offset()));
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "../include/persistent_list.h"
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+    struct point {
+        int x;
+        int y;
+        bool operator==(const point&) const = default;
+    };
+
+    // Файл пула во временном каталоге, удаляется после теста
+    class PersistentListTest : public ::testing::Test {
+        protected:
+            std::string path;
+
+            void SetUp() override {
+                path = (std::filesystem::temp_directory_path() /
+                        ("persistent_list_" + std::to_string(::getpid()) + ".pool")).string();
+                std::filesystem::remove(path);
+            }
+            void TearDown() override {
+                std::filesystem::remove(path);
+            }
+    };
+}
+
+// Тест 1: Список открывается заново с теми же элементами
+TEST_F(PersistentListTest, ReopensWithSameElements) {
+    {
+        persistent_list<point> list(path, 64 * 1024);
+        EXPECT_TRUE(list.list().empty());
+        for (int i = 0; i < 100; ++i) {
+            list.list().push_back({i, -i});
+        }
+        list.list().push_front({-1, 1});
+    }
+    persistent_list<point> reopened(path, 0);
+    EXPECT_TRUE(reopened.opened_cleanly());
+    ASSERT_EQ(reopened.list().size(), 101);
+    EXPECT_EQ(*reopened.list().begin(), (point{-1, 1}));
+    EXPECT_EQ(*reopened.list().rbegin(), (point{99, -99}));
+    int expected = 0;
+    for (auto it = std::next(reopened.list().begin()); it != reopened.list().end(); ++it, ++expected) {
+        EXPECT_EQ(*it, (point{expected, -expected}));
+    }
+}
+
+// Тест 2: Изменения после повторного открытия сохраняются, память переиспользуется
+TEST_F(PersistentListTest, ModifyAcrossSessions) {
+    {
+        persistent_list<int> list(path, 64 * 1024);
+        for (int i = 0; i < 10; ++i) {
+            list.list().push_back(i);
+        }
+    }
+    size_t used = 0;
+    {
+        persistent_list<int> list(path, 0);
+        used = list.memory_resource().get_used_memory();
+        // Узлы прошлого сеанса освобождаются и достаются новым элементам
+        list.list().pop_front();
+        list.list().pop_back();
+        list.list().push_back(100);
+        list.list().push_front(-100);
+        EXPECT_EQ(list.memory_resource().get_used_memory(), used);
+        list.flush();
+    }
+    persistent_list<int> list(path, 0);
+    std::vector<int> values(list.list().begin(), list.list().end());
+    EXPECT_EQ(values, (std::vector<int>{-100, 1, 2, 3, 4, 5, 6, 7, 8, 100}));
+    list.list().clear();
+    EXPECT_EQ(list.memory_resource().get_fragmentation(), 0.0);
+}
+
+// Тест 3: Сеанс, завершившийся без деструктора, виден при следующем открытии
+TEST_F(PersistentListTest, DetectsUncleanShutdown) {
+    pid_t child = ::fork();
+    ASSERT_NE(child, -1);
+    if (child == 0) {
+        auto* list = new persistent_list<int>(path, 64 * 1024);
+        for (int i = 0; i < 5; ++i) {
+            list->list().push_back(i);
+        }
+        ::_exit(0); // Падение процесса: деструкторы не вызываются
+    }
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+
+    {
+        // Записи процесса остались в страничном кэше и видны через файл
+        persistent_list<int> list(path, 0);
+        EXPECT_FALSE(list.opened_cleanly());
+        EXPECT_EQ(std::vector<int>(list.list().begin(), list.list().end()), (std::vector<int>{0, 1, 2, 3, 4}));
+    }
+    persistent_list<int> list(path, 0);
+    EXPECT_TRUE(list.opened_cleanly());
+}
+
+// Тест 4: Память, освобождённая в прошлых сеансах, переиспользуется
+TEST_F(PersistentListTest, FreedBlocksSurviveSessions) {
+    for (int session = 0; session < 8; ++session) {
+        persistent_list<int> list(path, 64 * 1024);
+        EXPECT_EQ(list.list().size(), static_cast<size_t>(session == 0 ? 0 : 500));
+        for (int i = 0; i < 1000; ++i) {
+            list.list().push_back(i);
+        }
+        // Освобождаются узлы прошлого сеанса и половина новых
+        while (list.list().size() > 500) {
+            list.list().pop_front();
+        }
+        // Одновременно живут не больше 1500 узлов по 32 байта
+        EXPECT_LE(list.memory_resource().get_used_memory(), 48 * 1024);
+    }
+    {
+        // Узлы освобождаются и целиком, как в прежнем сценарии с bad_alloc
+        persistent_list<int> list(path, 0);
+        list.list().clear();
+    }
+    for (int session = 0; session < 8; ++session) {
+        persistent_list<int> list(path, 0);
+        for (int i = 0; i < 1000; ++i) {
+            list.list().push_back(i);
+        }
+        for (int i = 0; i < 1000; ++i) {
+            list.list().pop_back();
+        }
+        EXPECT_TRUE(list.list().empty());
+    }
+    persistent_list<int> list(path, 0);
+    EXPECT_EQ(list.memory_resource().get_fragmentation(), 0.0);
+}
@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include "../include/shared_memory_resource.h"
+#include "../include/offset_linked_list.h"
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+    // Запускает body в дочернем процессе и возвращает его код завершения.
+    // Проверки gtest в дочернем процессе не видны, поэтому результат - код
+    template <typename Body>
+    int run_in_child(Body body) {
+        pid_t child = ::fork();
+        if (child == 0) {
+            int code = 1;
+            try {
+                code = body();
+            } catch (...) {
+                code = 2;
+            }
+            ::_exit(code); // Без деструкторов объектов родителя
+        }
+        int status = 0;
+        if (child < 0 || ::waitpid(child, &status, 0) != child || !WIFEXITED(status)) {
+            return -1;
+        }
+        return WEXITSTATUS(status);
+    }
+
+    std::string segment_name(const char* test) {
+        return "/laboratory5_" + std::string(test) + "_" + std::to_string(::getpid());
+    }
+}
+
+// Тест 1: Переиспользование блоков и проверка аргументов
+TEST(SharedMemoryResourceTest, AllocateAndReuse) {
+    shared_memory_resource mr(64 * 1024);
+    size_t used = mr.get_used_memory();
+
+    void* small = mr.allocate(24, alignof(int));
+    void* large = mr.allocate(4096, alignof(std::max_align_t));
+    EXPECT_TRUE(mr.owns(small));
+    EXPECT_TRUE(mr.owns(large));
+    // Каждый блок начинается с заголовка в одну гранулу
+    EXPECT_EQ(mr.get_used_memory(), used + (32 + 16) + (4096 + 16));
+
+    mr.deallocate(small, 24, alignof(int));
+    EXPECT_EQ(mr.allocate(32, alignof(int)), small);
+    // Последний блок возвращается в "хвост" и выдаётся заново по частям
+    mr.deallocate(large, 4096, alignof(std::max_align_t));
+    EXPECT_EQ(mr.get_used_memory(), used + 32 + 16);
+    EXPECT_EQ(mr.allocate(2048, alignof(int)), large);
+    EXPECT_EQ(mr.allocate(2048, alignof(int)), static_cast<char*>(large) + 2048 + 16);
+    EXPECT_EQ(mr.get_used_memory(), used + (32 + 16) + 2 * (2048 + 16));
+
+    int outside = 0;
+    EXPECT_THROW(mr.deallocate(&outside, sizeof(int), alignof(int)), std::invalid_argument);
+    EXPECT_THROW((void)mr.allocate(64, 64), std::invalid_argument);
+    EXPECT_THROW((void)mr.allocate(1024 * 1024, alignof(int)), std::bad_alloc);
+    EXPECT_THROW(shared_memory_resource(16), std::system_error);
+}
+
+// Тест 2: Дочерний процесс открывает сегмент по имени по другому адресу,
+// обходит список родителя и дописывает в него без копирования
+TEST(SharedMemoryResourceTest, ListSharedBetweenProcesses) {
+    std::string name = segment_name("list");
+    shared_memory_resource mr(name, 1024 * 1024);
+    offset_linked_list<int> list(&mr, mr.base(), mr.size());
+    for (int i = 0; i < 1000; ++i) {
+        list.push_back(i);
+    }
+    mr.set_root(static_cast<char*>(mr.base()) + list.control_offset());
+
+    int code = run_in_child([&name] {
+        shared_memory_resource opened(name);
+        if (opened.base() == nullptr || opened.get_root() == nullptr) {
+            return 3;
+        }
+        auto offset = static_cast<offset_linked_list<int>::offset_type>(
+            static_cast<char*>(opened.get_root()) - static_cast<char*>(opened.base()));
+        offset_linked_list<int> shared(&opened, opened.base(), opened.size(), offset);
+        long long sum = 0;
+        for (int value : shared) {
+            sum += value;
+        }
+        if (shared.size() != 1000 || sum != 999 * 1000 / 2) {
+            return 4;
+        }
+        shared.push_back(-1);
+        shared.pop_front();
+        shared.detach(); // Список остаётся в сегменте
+        return 0;
+    });
+    ASSERT_EQ(code, 0);
+
+    EXPECT_EQ(list.size(), 1000);
+    EXPECT_EQ(*list.begin(), 1);
+    EXPECT_EQ(*list.rbegin(), -1);
+    // Сегмент с тем же именем нельзя создать второй раз
+    EXPECT_THROW(shared_memory_resource(name, 4096), std::system_error);
+}
+
+// Тест 3: Несколько процессов одновременно выделяют и освобождают память
+TEST(SharedMemoryResourceTest, ConcurrentProcesses) {
+    constexpr int PROCESSES = 4;
+    constexpr int ROUNDS = 2000;
+    shared_memory_resource mr(4 * 1024 * 1024);
+
+    std::vector<pid_t> children;
+    for (int id = 0; id < PROCESSES; ++id) {
+        pid_t child = ::fork();
+        ASSERT_NE(child, -1);
+        if (child == 0) {
+            // Каждый процесс заполняет свои блоки своим байтом; пересечение
+            // блоков разных процессов испортило бы чужое содержимое
+            std::vector<std::pair<char*, size_t>> live;
+            int code = 0;
+            for (int round = 0; round < ROUNDS && code == 0; ++round) {
+                size_t bytes = 16 + static_cast<size_t>((round * 37 + id * 11) % 600);
+                char* p = static_cast<char*>(mr.allocate(bytes, alignof(int)));
+                std::memset(p, 'A' + id, bytes);
+                live.emplace_back(p, bytes);
+                if (round % 3 == 2) {
+                    auto [old, old_bytes] = live[live.size() / 2];
+                    for (size_t i = 0; i < old_bytes; ++i) {
+                        if (old[i] != 'A' + id) {
+                            code = 5;
+                        }
+                    }
+                    mr.deallocate(old, old_bytes, alignof(int));
+                    live.erase(live.begin() + static_cast<std::ptrdiff_t>(live.size() / 2));
+                }
+            }
+            for (auto [p, bytes] : live) {
+                for (size_t i = 0; i < bytes; ++i) {
+                    if (p[i] != 'A' + id) {
+                        code = 5;
+                    }
+                }
+                mr.deallocate(p, bytes, alignof(int));
+            }
+            ::_exit(code);
+        }
+        children.push_back(child);
+    }
+    for (pid_t child : children) {
+        int status = 0;
+        ASSERT_EQ(::waitpid(child, &status, 0), child);
+        ASSERT_TRUE(WIFEXITED(status));
+        EXPECT_EQ(WEXITSTATUS(status), 0);
+    }
+    // Все блоки возвращены в корзины: новый запрос не сдвигает "хвост"
+    size_t used = mr.get_used_memory();
+    mr.deallocate(mr.allocate(64, alignof(int)), 64, alignof(int));
+    EXPECT_EQ(mr.get_used_memory(), used);
+}
+
+// Тест 4: Соседние свободные блоки сливаются, повторное освобождение
+// отвергается, в том числе если первым блок освободил другой процесс
+TEST(SharedMemoryResourceTest, CoalescingAndDoubleFree) {
+    shared_memory_resource mr(64 * 1024);
+    size_t used = mr.get_used_memory();
+
+    void* a = mr.allocate(64, alignof(int));
+    void* b = mr.allocate(64, alignof(int));
+    void* guard = mr.allocate(64, alignof(int));
+    mr.deallocate(a, 64, alignof(int));
+    mr.deallocate(b, 64, alignof(int));
+    // a и b слились: блок на оба места вместе с заголовком b
+    void* merged = mr.allocate(64 + 16 + 64, alignof(int));
+    EXPECT_EQ(merged, a);
+    EXPECT_THROW(mr.deallocate(b, 64, alignof(int)), std::invalid_argument);
+    mr.deallocate(merged, 64 + 16 + 64, alignof(int));
+    EXPECT_THROW(mr.deallocate(a, 64 + 16 + 64, alignof(int)), std::invalid_argument);
+
+    // Блок освобождает дочерний процесс, повторное освобождение в родителе отвергается
+    int code = run_in_child([&mr, guard] {
+        mr.deallocate(guard, 64, alignof(int));
+        return 0;
+    });
+    ASSERT_EQ(code, 0);
+    EXPECT_THROW(mr.deallocate(guard, 64, alignof(int)), std::invalid_argument);
+
+    // Все блоки слились и вернулись в "хвост"
+    EXPECT_EQ(mr.get_used_memory(), used);
+    // Размер, не совпадающий с выделенным, тоже отвергается
+    void* c = mr.allocate(256, alignof(int));
+    EXPECT_THROW(mr.deallocate(c, 32, alignof(int)), std::invalid_argument);
+    mr.deallocate(c, 256, alignof(int));
+}
@@ -3,6 +3,9 @@
 #include "../include/fixed_block_memory_resource.h"
 #include <string>
 #include <sstream>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
 
 // Структура Animal для тестирования
 struct Animal {
@@ -51,6 +54,35 @@ struct Car {
     }
 };
 
+// pmr-версии структур: строки выделяются из переданного ресурса.
+// allocator_type и конструкторы с allocator_arg_t делают их allocator-aware
+struct PmrColor {
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+    std::pmr::string name;
+    int r, g, b;
+
+    PmrColor(std::allocator_arg_t, const allocator_type& alloc, std::string_view n, int red, int green, int blue)
+        : name(n, alloc), r(red), g(green), b(blue) {}
+    PmrColor(std::allocator_arg_t, const allocator_type& alloc, const PmrColor& other)
+        : name(other.name, alloc), r(other.r), g(other.g), b(other.b) {}
+    PmrColor(const PmrColor& other) = default;
+};
+
+struct PmrAnimal {
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+    std::pmr::string name;
+    int age;
+    double weight;
+
+    // Аллокатор последним аргументом - второй вариант uses-allocator
+    PmrAnimal(std::string_view n, int a, double w, const allocator_type& alloc = {})
+        : name(n, alloc), age(a), weight(w) {}
+    PmrAnimal(const PmrAnimal& other, const allocator_type& alloc = {})
+        : name(other.name, alloc), age(other.age), weight(other.weight) {}
+};
+
 // Тесты с Animal
 TEST(StructTest, AnimalBasic) {
     fixed_block_memory_resource mr(4096);
@@ -271,3 +303,48 @@ TEST(StructTest, StructCopy) {
     auto it = list.begin();
     EXPECT_DOUBLE_EQ(it->price, 30000.0);
 }
+
+// Тест: pmr-поля элементов получают ресурс списка (uses-allocator construction)
+TEST(StructTest, PmrPayloadUsesListResource) {
+    fixed_block_memory_resource mr(64 * 1024);
+    doubly_linked_list<PmrColor> colors(&mr);
+    doubly_linked_list<PmrAnimal> animals(&mr);
+
+    // Имена длиннее SSO-буфера, чтобы строка выделяла память
+    colors.emplace_back("Ultramarine blue from the deep ocean", 18, 10, 143);
+    PmrColor outside(std::allocator_arg, {}, "Viridian green of the summer forest", 64, 130, 109);
+    colors.push_back(outside);
+    animals.emplace_back("Whiskers the extraordinarily fluffy cat", 3, 4.5);
+
+    for (const PmrColor& color : colors) {
+        EXPECT_EQ(color.name.get_allocator().resource(), &mr);
+        EXPECT_TRUE(mr.owns(color.name.data()));
+    }
+    EXPECT_FALSE(mr.owns(outside.name.data()));
+    EXPECT_EQ(animals.begin()->name.get_allocator().resource(), &mr);
+    EXPECT_TRUE(mr.owns(animals.begin()->name.data()));
+
+    // Копия списка в другой пул переносит и строки
+    fixed_block_memory_resource other_mr(64 * 1024);
+    doubly_linked_list<PmrAnimal> copy(animals, &other_mr);
+    EXPECT_EQ(copy.begin()->name, animals.begin()->name);
+    EXPECT_TRUE(other_mr.owns(copy.begin()->name.data()));
+}
+
+// Тест: вложенные контейнеры целиком живут в одном пуле
+TEST(StructTest, NestedContainersShareResource) {
+    fixed_block_memory_resource mr(64 * 1024);
+    {
+        doubly_linked_list<std::pmr::string> names(&mr);
+        names.emplace_back(100, 'x');
+        EXPECT_TRUE(mr.owns(names.begin()->data()));
+
+        doubly_linked_list<doubly_linked_list<int>> rows(&mr);
+        rows.emplace_back().push_back(1);
+        rows.begin()->push_back(2);
+        EXPECT_EQ(rows.begin()->get_allocator().resource(), &mr);
+        EXPECT_TRUE(mr.owns(&*rows.begin()->begin()));
+    }
+    // Деструкторы вернули все блоки, включая память строк и вложенных списков
+    EXPECT_EQ(mr.get_fragmentation(), 0.0);
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "../include/typed_node_pool.h"
+#include "../include/doubly_linked_list.h"
+#include "../include/fixed_block_memory_resource.h"
+#include <cstdint>
+#include <set>
+#include <vector>
+
+// Тест 1: Слоты выровнены, различны и переиспользуются в порядке LIFO
+TEST(TypedNodePoolTest, AllocateDeallocate) {
+    typed_node_pool<24, 8> pool(std::pmr::get_default_resource(), 4);
+    std::set<void*> slots;
+    for (int i = 0; i < 10; ++i) {
+        void* p = pool.allocate_node();
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % 8, 0);
+        slots.insert(p);
+    }
+    EXPECT_EQ(slots.size(), 10);
+
+    void* first = *slots.begin();
+    void* second = *std::next(slots.begin());
+    pool.deallocate_node(first);
+    pool.deallocate_node(second);
+    EXPECT_EQ(pool.allocate_node(), second);
+    EXPECT_EQ(pool.allocate_node(), first);
+}
+
+// Тест 2: Как memory_resource пул отдаёт крупные запросы upstream
+TEST(TypedNodePoolTest, MemoryResourceInterface) {
+    fixed_block_memory_resource upstream(64 * 1024);
+    {
+        typed_node_pool<32, 16> pool(&upstream);
+        std::pmr::memory_resource& mr = pool;
+
+        void* small = mr.allocate(32, 16);
+        void* large = mr.allocate(1000, 16);
+        EXPECT_TRUE(upstream.owns(small));
+        EXPECT_TRUE(upstream.owns(large));
+        size_t used = upstream.get_used_memory();
+        mr.deallocate(large, 1000, 16);
+        mr.deallocate(small, 32, 16);
+        // Слот вернулся в пул, а не upstream
+        EXPECT_EQ(mr.allocate(16, 8), small);
+        EXPECT_EQ(upstream.get_used_memory(), used);
+
+        EXPECT_TRUE(mr.is_equal(pool));
+        EXPECT_FALSE(mr.is_equal(upstream));
+    }
+    // Деструктор пула вернул все куски
+    EXPECT_EQ(upstream.get_fragmentation(), 0.0);
+}
+
+// Тест 3: release() возвращает куски upstream, после него пул снова работает
+TEST(TypedNodePoolTest, Release) {
+    fixed_block_memory_resource upstream(64 * 1024);
+    typed_node_pool<16, 8> pool(&upstream, 8);
+    for (int i = 0; i < 100; ++i) {
+        pool.allocate_node();
+    }
+    pool.release();
+    EXPECT_EQ(upstream.get_fragmentation(), 0.0);
+    EXPECT_TRUE(upstream.owns(pool.allocate_node()));
+    EXPECT_EQ(pool.upstream_resource(), &upstream);
+}
+
+// Тест 4: Список со статическим аллокатором над пулом узлов
+TEST(TypedNodePoolTest, PooledList) {
+    node_pool_for<int> pool;
+    pooled_doubly_linked_list<int> list(&pool);
+    EXPECT_EQ(node_pool_for<int>::node_size, sizeof(doubly_linked_list_node<int>));
+
+    for (int i = 0; i < 1000; ++i) {
+        list.push_back(999 - i);
+    }
+    list.sort();
+    EXPECT_EQ(list.size(), 1000);
+    int expected = 0;
+    for (int value : list) {
+        EXPECT_EQ(value, expected++);
+    }
+
+    // Освобождённые узлы переиспользуются
+    void* last_node = &*std::prev(list.end());
+    list.pop_back();
+    list.push_front(-1);
+    EXPECT_EQ(static_cast<void*>(&*list.begin()), last_node);
+
+    // Копия и перемещение сохраняют тот же пул
+    pooled_doubly_linked_list<int> copy(list);
+    EXPECT_EQ(copy.get_allocator().resource(), &pool);
+    EXPECT_EQ(copy.size(), 1000);
+    pooled_doubly_linked_list<int> moved(std::move(copy));
+    EXPECT_TRUE(copy.empty());
+    moved.splice(moved.end(), list);
+    EXPECT_EQ(moved.size(), 2000);
+
+    node_pool_for<int> other_pool;
+    pooled_doubly_linked_list<int> foreign({1, 2, 3}, &other_pool);
+    EXPECT_THROW(moved.splice(moved.end(), foreign), std::invalid_argument);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "../include/unrolled_linked_list.h"
+#include "../include/fixed_block_memory_resource.h"
+#include <algorithm>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <vector>
+
+// Тест 1: Типы итератора совпадают с doubly_linked_list
+TEST(UnrolledLinkedListTest, TypeTraits) {
+    using list_type = unrolled_linked_list<int, 4>;
+    EXPECT_TRUE(std::bidirectional_iterator<list_type::iterator>);
+    EXPECT_TRUE(std::bidirectional_iterator<list_type::const_iterator>);
+    EXPECT_TRUE(std::ranges::bidirectional_range<list_type>);
+    EXPECT_TRUE(std::ranges::bidirectional_range<const list_type>);
+    EXPECT_EQ(list_type::node_capacity, 4);
+}
+
+// Тест 2: push_back и push_front через границы узлов
+TEST(UnrolledLinkedListTest, PushBothEnds) {
+    fixed_block_memory_resource mr(4096);
+    unrolled_linked_list<int, 4> list(&mr);
+    EXPECT_TRUE(list.empty());
+
+    for (int i = 0; i < 10; ++i) {
+        list.push_back(i);
+    }
+    for (int i = -1; i >= -10; --i) {
+        list.push_front(i);
+    }
+    EXPECT_EQ(list.size(), 20);
+
+    std::vector<int> expected;
+    for (int i = -10; i < 10; ++i) {
+        expected.push_back(i);
+    }
+    EXPECT_EQ(std::vector<int>(list.begin(), list.end()), expected);
+    EXPECT_TRUE(std::equal(list.rbegin(), list.rend(), expected.rbegin()));
+    EXPECT_EQ(*std::prev(list.end()), 9);
+}
+
+// Тест 3: pop освобождает опустевшие узлы
+TEST(UnrolledLinkedListTest, PopReleasesNodes) {
+    fixed_block_memory_resource mr(4096);
+    unrolled_linked_list<int, 4> list(&mr);
+    for (int i = 0; i < 9; ++i) {
+        list.push_back(i);
+    }
+    size_t used = mr.get_used_memory();
+
+    list.pop_front();
+    list.pop_back();
+    EXPECT_EQ(std::vector<int>(list.begin(), list.end()), (std::vector<int>{1, 2, 3, 4, 5, 6, 7}));
+    while (!list.empty()) {
+        list.pop_back();
+    }
+    EXPECT_THROW(list.pop_back(), std::out_of_range);
+    EXPECT_THROW(list.pop_front(), std::out_of_range);
+    EXPECT_EQ(list.begin(), list.end());
+
+    // Узлы вернулись в пул и переиспользуются
+    for (int i = 0; i < 9; ++i) {
+        list.push_front(i);
+    }
+    EXPECT_EQ(mr.get_used_memory(), used);
+}
+
+// Тест 4: Нетривиальные элементы конструируются и разрушаются по одному разу
+TEST(UnrolledLinkedListTest, NonTrivialElements) {
+    fixed_block_memory_resource mr(64 * 1024);
+    {
+        unrolled_linked_list<std::string, 3> list(&mr);
+        for (int i = 0; i < 10; ++i) {
+            list.emplace_back(40, static_cast<char>('a' + i)); // Строки вне SSO
+        }
+        list.emplace_front("front");
+        list.pop_back();
+        list.pop_front();
+        EXPECT_EQ(list.size(), 9);
+        EXPECT_EQ(list.begin()->size(), 40);
+        EXPECT_EQ((*list.begin())[0], 'a');
+        EXPECT_EQ((*std::prev(list.end()))[0], 'i');
+    }
+    // Деструктор списка вернул все узлы
+    EXPECT_EQ(mr.get_fragmentation(), 0.0);
+}
+
+// Тест 5: Изменение элементов через итератор и const-обход
+TEST(UnrolledLinkedListTest, IteratorModify) {
+    fixed_block_memory_resource mr(4096);
+    unrolled_linked_list<int, 2> list(&mr);
+    for (int i = 0; i < 5; ++i) {
+        list.push_back(i);
+    }
+    for (auto& value : list) {
+        value *= 10;
+    }
+    const auto& view = list;
+    int expected = 0;
+    for (auto it = view.cbegin(); it != view.cend(); ++it) {
+        EXPECT_EQ(*it, expected);
+        expected += 10;
+    }
+    unrolled_linked_list<int, 2>::const_iterator converted = list.begin();
+    EXPECT_EQ(*converted, 0);
+    EXPECT_EQ(*view.crbegin(), 40);
+}